@@ -0,0 +1,603 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#include "cjson.h"
+
+/*
+  性能测试：在内存里生成测试语料（数字多的、字符串多的、嵌套深的、键很多的、格式化的和紧凑的），
+  重复解析/输出/查找/复制/释放，报告MB/s、每次操作的纳秒数、每次操作申请内存的次数和进程的峰值内存。
+  用法：cjson_bench [-j] [重复次数]，-j时每个结果输出一行JSON，方便脚本比较前后两次的结果。
+  和逐字节的字符串扫描比较时，把cjson.c加上-DCJSON_NO_SIMD再编译一份。
+  并行解析要链接pthread（-lpthread）。
+*/
+
+static int rounds = 20;
+static int json_output;/*-j：每行一个JSON对象*/
+static const char *section_name = "";
+
+/*统计申请内存的次数，并行测试时几个线程一起加*/
+static size_t allocs;
+static void *count_malloc(size_t sz) {
+  __atomic_fetch_add(&allocs, 1, __ATOMIC_RELAXED);
+  return malloc(sz);
+}
+static cjson_Hooks count_hooks = {count_malloc, free};
+
+/*可以追加的字符串缓冲*/
+typedef struct
+{
+  char *buf;
+  size_t len, cap;
+} text;
+
+static void text_add(text *t, const char *s) {
+  size_t n = strlen(s);
+  if (t->len + n + 1 > t->cap) {
+    t->cap = (t->len + n + 1) * 2;
+    t->buf = (char *)realloc(t->buf, t->cap);
+  }
+  memcpy(t->buf + t->len, s, n + 1);
+  t->len += n;
+}
+
+/*固定种子的xorshift，保证每次生成的语料一样*/
+static unsigned long long seed = 88172645463325252ULL;
+static unsigned long long next_rand(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+static double seconds(void) {return (double)clock() / CLOCKS_PER_SEC;}
+/*多线程时clock()是所有线程加起来的CPU时间，要用墙上时间*/
+static double wall_seconds(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*进程到目前为止的峰值内存，KB，取不到时为0*/
+static long peak_rss_kb(void) {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru)) return 0;
+#ifdef __APPLE__
+  return ru.ru_maxrss / 1024;/*macOS是字节*/
+#else
+  return ru.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+static void section(const char *name) {
+  section_name = name;
+  if (!json_output) printf("== %s ==\n", name);
+}
+
+/*开始计时：清零申请次数，返回clock()的秒数*/
+static double bench_start(void) {
+  allocs = 0;
+  return seconds();
+}
+/*报告：名字、每轮处理的字节数（0表示不按字节算）、总共做了几次操作、总耗时*/
+static void report(const char *name, size_t bytes, double ops, double elapsed) {
+  double mbs = elapsed > 0 ? bytes * (double)rounds / elapsed / 1e6 : 0.0;
+  double ns = ops > 0 ? elapsed * 1e9 / ops : 0.0, per_op = ops > 0 ? allocs / ops : 0.0;
+  if (json_output)
+    printf("{\"section\":\"%s\",\"name\":\"%s\",\"mb_s\":%.1f,\"ns_op\":%.1f,\"allocs_op\":%.2f,\"peak_rss_kb\":%ld}\n",
+           section_name, name, mbs, ns, per_op, peak_rss_kb());
+  else if (bytes)
+    printf("%-30s %10.1f MB/s %12.0f ns/op %10.1f allocs/op\n", name, mbs, ns, per_op);
+  else
+    printf("%-30s %15s %12.1f ns/op %10.1f allocs/op\n", name, "", ns, per_op);
+}
+
+/*options为0时和cjson_Parse一样，cjson_Option_Lazy测惰性解析*/
+static void bench_parse_opts(const char *name, const char *json, int options) {
+  double start;
+  int i;
+  cjson *root;
+  cjson_Context ctx;
+  cjson_InitContext(&ctx, &count_hooks);
+  ctx.options = options;
+  start = bench_start();
+  for (i = 0; i < rounds; ++i) {
+    root = cjson_ParseWithContext(&ctx, json, 0, 0);
+    if (!root) {
+      fprintf(stderr, "%s: parse failed\n", name);
+      return;
+    }
+    cjson_Delete(root);
+  }
+  report(name, strlen(json), rounds, seconds() - start);
+}
+static void bench_parse(const char *name, const char *json) {bench_parse_opts(name, json, 0);}
+/*节点从节点池中分配，删除时放回池里给下一轮用，只剩字符串要申请内存*/
+static void bench_parse_pool(const char *name, const char *json) {
+  double start;
+  int i;
+  cjson *root;
+  cjson_Context ctx;
+  cjson_InitContext(&ctx, &count_hooks);
+  ctx.pool = cjson_PoolCreateWithContext(&ctx, 0, 0);
+  start = bench_start();
+  for (i = 0; i < rounds; ++i) {
+    root = cjson_ParseWithContext(&ctx, json, 0, 0);
+    if (!root) {
+      fprintf(stderr, "%s: parse failed\n", name);
+      break;
+    }
+    cjson_DeleteWithContext(&ctx, root);
+  }
+  report(name, strlen(json), rounds, seconds() - start);
+  cjson_PoolDestroy(ctx.pool);
+}
+
+/*用推式解析器按chunk字节一块块地解析*/
+static void bench_push(const char *name, const char *json, size_t chunk) {
+  double start;
+  int i;
+  size_t len = strlen(json), at, n;
+  cjson_PushParser *pp;
+  cjson *root;
+  start = bench_start();
+  for (i = 0; i < rounds; ++i) {
+    pp = cjson_PushParserCreate();
+    for (at = 0; at < len; at += n) {
+      n = len - at < chunk ? len - at : chunk;
+      cjson_PushParserFeed(pp, json + at, n);
+    }
+    root = cjson_PushParserFinish(pp);
+    cjson_PushParserDestroy(pp);
+    if (!root) {
+      fprintf(stderr, "%s: parse failed\n", name);
+      return;
+    }
+    cjson_Delete(root);
+  }
+  report(name, len, rounds, seconds() - start);
+}
+
+/*NDJSON有几行，按每篇文档计算ns/op*/
+static double count_lines(const char *json) {
+  double n = 0;
+  for (; *json; ++json) n += (*json == '\n');
+  return n;
+}
+/*NDJSON：按行切开，每行用cjson_ParseWithLength解析再释放*/
+static void bench_lines(const char *name, const char *json) {
+  double start;
+  int i;
+  const char *p, *nl;
+  cjson *root;
+  start = bench_start();
+  for (i = 0; i < rounds; ++i) {
+    for (p = json; *p; p = nl + 1) {
+      if (!(nl = strchr(p, '\n'))) nl = p + strlen(p);
+      if (!(root = cjson_ParseWithLength(p, nl - p))) {
+        fprintf(stderr, "%s: parse failed\n", name);
+        return;
+      }
+      cjson_Delete(root);
+      if (!*nl) break;
+    }
+  }
+  report(name, strlen(json), rounds * count_lines(json), seconds() - start);
+}
+/*NDJSON：用批量解析器一篇一篇地解析*/
+static void bench_batch(const char *name, const char *json) {
+  double start;
+  int i;
+  size_t len = strlen(json);
+  cjson_Batch *batch;
+  cjson *root;
+  start = bench_start();
+  for (i = 0; i < rounds; ++i) {
+    batch = cjson_BatchCreate(json, len);
+    while (cjson_BatchNext(batch, &root)) {
+      if (!root) {
+        fprintf(stderr, "%s: parse failed\n", name);
+        return;
+      }
+    }
+    cjson_BatchDestroy(batch);
+  }
+  report(name, len, rounds * count_lines(json), seconds() - start);
+}
+
+/*用threads个线程并行解析，lines为1时按NDJSON解析*/
+static void bench_parallel(const char *json, int lines, int threads) {
+  double start;
+  int i;
+  size_t len = strlen(json);
+  char name[64];
+  cjson *root;
+  sprintf(name, "parse %s %d threads", lines ? "ndjson" : "array", threads);
+  bench_start();
+  start = wall_seconds();
+  for (i = 0; i < rounds; ++i) {
+    root = lines ? cjson_ParseLinesParallel(json, len, threads) : cjson_ParseParallel(json, len, threads);
+    if (!root) {
+      fprintf(stderr, "%s: parse failed\n", name);
+      return;
+    }
+    cjson_Delete(root);
+  }
+  report(name, len, rounds, wall_seconds() - start);
+}
+
+/*查找：对象的每个键各找一次，case_sensitive时用cjson_GetObjectItemCaseSensitive*/
+static void bench_lookup(const char *name, const char *json, int case_sensitive) {
+  double start;
+  int i, k, n = 0;
+  cjson *root = cjson_Parse(json), *c, *found = 0;
+  char **keys;
+  if (!root) {
+    fprintf(stderr, "%s: parse failed\n", name);
+    return;
+  }
+  keys = (char **)malloc(cjson_GetArraySize(root) * sizeof(char *));
+  for (c = root->child; c; c = c->next) keys[n++] = c->string;
+  cjson_BuildIndex(root);/*查找不会自己建索引*/
+  start = bench_start();
+  for (i = 0; i < rounds; ++i)
+    for (k = 0; k < n; ++k)
+      found = case_sensitive ? cjson_GetObjectItemCaseSensitive(root, keys[k]) : cjson_GetObjectItem(root, keys[k]);
+  report(name, 0, (double)rounds * n, seconds() - start);
+  if (!found) fprintf(stderr, "%s: lookup failed\n", name);
+  free(keys);
+  cjson_Delete(root);
+}
+
+/*复制和释放整棵树，分开计时*/
+static void bench_tree(const char *name, const char *json) {
+  double start, dup = 0, del = 0, later = 0;
+  size_t dup_allocs = 0;
+  size_t len = strlen(json);
+  int i;
+  char label[64];
+  cjson *root = cjson_Parse(json), *copy;
+  cjson_Reclaimer *r;
+  if (!root) {
+    fprintf(stderr, "%s: parse failed\n", name);
+    return;
+  }
+  r = cjson_ReclaimerCreate();
+  for (i = 0; i < rounds; ++i) {
+    start = bench_start();
+    copy = cjson_Duplicate(root, 1);
+    dup += seconds() - start;
+    dup_allocs += allocs;
+    start = seconds();
+    cjson_Delete(copy);
+    del += seconds() - start;
+  }
+  /*交给后台线程删除时调用者花的时间，后台线程用的CPU时间不算*/
+  for (i = 0; i < rounds; ++i) {
+    copy = cjson_Duplicate(root, 1);
+    start = wall_seconds();
+    cjson_DeleteLater(r, copy);
+    later += wall_seconds() - start;
+  }
+  cjson_ReclaimerDestroy(r);
+  allocs = dup_allocs;
+  sprintf(label, "duplicate %s", name);
+  report(label, len, rounds, dup);
+  allocs = 0;
+  sprintf(label, "delete %s", name);
+  report(label, len, rounds, del);
+  sprintf(label, "delete later %s", name);
+  report(label, len, rounds, later);
+  cjson_Delete(root);
+}
+
+/*SAX解析，只把数字加起来，不建树*/
+static int sum_number(void *user, double d, long long i) {
+  (void)i;
+  *(double *)user += d;
+  return 1;
+}
+static void bench_sax(const char *name, const char *json) {
+  cjson_SaxHandler handler = {0};
+  double start, sum = 0;
+  size_t len = strlen(json);
+  int i;
+  handler.number = sum_number;
+  start = bench_start();
+  for (i = 0; i < rounds; ++i) {
+    if (cjson_SaxParse(json, len, &handler, &sum)) {
+      fprintf(stderr, "%s: parse failed\n", name);
+      return;
+    }
+  }
+  report(name, len, rounds, seconds() - start);
+}
+
+/*先解析一次，再重复输出，按输出的字节数计算。prebuffer大于0时用cjson_PrintBuffered*/
+static void bench_print_mode(const char *name, const char *json, int fmt, int prebuffer) {
+  double start;
+  int i;
+  size_t bytes = 0;
+  char *out;
+  cjson *root = cjson_Parse(json);
+  if (!root) {
+    fprintf(stderr, "%s: parse failed\n", name);
+    return;
+  }
+  start = bench_start();
+  for (i = 0; i < rounds; ++i) {
+    if (prebuffer > 0) out = cjson_PrintBuffered(root, prebuffer, fmt);
+    else out = fmt ? cjson_Print(root) : cjson_PrintUnformatted(root);
+    bytes = strlen(out);
+    free(out);
+  }
+  report(name, bytes, rounds, seconds() - start);
+  cjson_Delete(root);
+}
+static void bench_print(const char *name, const char *json) {bench_print_mode(name, json, 0, 0);}
+
+/*流式输出的回调，只数字节*/
+static int count_write(void *user, const char *data, size_t len) {
+  (void)data;
+  *(size_t *)user += len;
+  return 1;
+}
+
+/*用4KB缓冲流式输出*/
+static void bench_print_stream(const char *name, const char *json, int fmt) {
+  double start;
+  int i;
+  size_t bytes = 0;
+  char buffer[4096];
+  cjson *root = cjson_Parse(json);
+  if (!root) {
+    fprintf(stderr, "%s: parse failed\n", name);
+    return;
+  }
+  start = bench_start();
+  for (i = 0; i < rounds; ++i) {
+    bytes = 0;
+    cjson_PrintToWriter(root, fmt, count_write, &bytes, buffer, sizeof(buffer));
+  }
+  report(name, bytes, rounds, seconds() - start);
+  cjson_Delete(root);
+}
+
+/*语料：整数数组*/
+static char *make_integers(int count) {
+  text t = {0};
+  char num[32];
+  int i;
+  text_add(&t, "[");
+  for (i = 0; i < count; ++i) {
+    sprintf(num, i ? ",%lld" : "%lld", (long long)(next_rand() % 2000000000000ULL) - 1000000000000LL);
+    text_add(&t, num);
+  }
+  text_add(&t, "]");
+  return t.buf;
+}
+
+/*语料：17位有效数字的浮点数组，每个都能精确还原*/
+static char *make_doubles(int count) {
+  text t = {0};
+  char num[40];
+  int i;
+  text_add(&t, "[");
+  for (i = 0; i < count; ++i) {
+    sprintf(num, i ? ",%.17g" : "%.17g", (double)(next_rand() >> 11) / 9007199254740992.0 * 1e6);
+    text_add(&t, num);
+  }
+  text_add(&t, "]");
+  return t.buf;
+}
+
+/*语料：遥测数据，对象里大部分是数字*/
+static char *make_telemetry(int count) {
+  text t = {0};
+  char rec[256];
+  int i;
+  text_add(&t, "[");
+  for (i = 0; i < count; ++i) {
+    sprintf(rec, "%s{\"ts\":%lld,\"id\":%d,\"temp\":%.2f,\"load\":%.4f,\"lat\":%.6f,\"lon\":%.6f,\"ok\":true}",
+            i ? "," : "", 1700000000000LL + i, (int)(next_rand() % 10000),
+            (double)(next_rand() % 10000) / 100.0, (double)(next_rand() % 10000) / 10000.0,
+            (double)(next_rand() % 180000000) / 1e6 - 90, (double)(next_rand() % 360000000) / 1e6 - 180);
+    text_add(&t, rec);
+  }
+  text_add(&t, "]");
+  return t.buf;
+}
+
+/*语料：日志，每条记录是几段长字符串，少量需要转义*/
+static char *make_logs(int count) {
+  static const char *words[] = {"request", "completed", "upstream", "timeout", "user", "session", "GET", "/api/v1/items",
+                                "200", "retrying", "connection", "reset", "\\\"quoted\\\"", "path\\\\to", "line\\n"};
+  text t = {0};
+  char rec[64];
+  int i, j;
+  text_add(&t, "[");
+  for (i = 0; i < count; ++i) {
+    sprintf(rec, "%s{\"ts\":%lld,\"level\":\"info\",\"msg\":\"", i ? "," : "", 1700000000000LL + i);
+    text_add(&t, rec);
+    for (j = 0; j < 40; ++j) {
+      text_add(&t, words[next_rand() % 15]);
+      text_add(&t, " ");
+    }
+    text_add(&t, "\",\"trace\":\"");
+    for (j = 0; j < 8; ++j) {
+      sprintf(rec, "%016llx", next_rand());
+      text_add(&t, rec);
+    }
+    text_add(&t, "\"}");
+  }
+  text_add(&t, "]");
+  return t.buf;
+}
+
+/*把数组的每一项输出成一行，得到NDJSON*/
+static char *make_ndjson(const char *json) {
+  cjson *root = cjson_Parse(json), *c;
+  text t = {0};
+  char *line;
+  for (c = root->child; c; c = c->next) {
+    line = cjson_PrintUnformatted(c);
+    text_add(&t, line);
+    text_add(&t, "\n");
+    free(line);
+  }
+  cjson_Delete(root);
+  return t.buf;
+}
+
+static void bench_strings(void) {
+  char *logs = make_logs(20000), *ndjson = make_ndjson(logs);
+  section("strings");
+  bench_parse("parse logs", logs);
+  bench_push("parse logs push 4KB", logs, 4096);
+  bench_sax("parse logs sax", logs);
+  bench_parse_opts("parse logs lazy", logs, cjson_Option_Lazy);
+  bench_parse_pool("parse logs pool", logs);
+  bench_print("print logs", logs);
+  bench_lines("parse ndjson per line", ndjson);
+  bench_batch("parse ndjson batch", ndjson);
+  free(logs);
+  free(ndjson);
+}
+
+/*把json重新格式化输出，缩进换成4个空格（常见格式化工具的样子），得到空白很多的语料*/
+static char *make_formatted(const char *json) {
+  cjson *root = cjson_Parse(json);
+  char *out = cjson_Print(root), *p, *q, *res;
+  size_t tabs = 0;
+  cjson_Delete(root);
+  for (p = out; *p; ++p) tabs += (*p == '\t');
+  res = q = (char *)malloc(strlen(out) + tabs * 3 + 1);
+  for (p = out; *p; ++p) {
+    if (*p == '\t') memcpy(q, "    ", 4), q += 4;
+    else *q++ = *p;
+  }
+  *q = 0;
+  free(out);
+  return res;
+}
+
+/*语料：count个depth层嵌套的对象，每层有几个标量*/
+static char *make_nested(int count, int depth) {
+  text t = {0};
+  int i, j;
+  text_add(&t, "[");
+  for (i = 0; i < count; ++i) {
+    if (i) text_add(&t, ",");
+    for (j = 0; j < depth; ++j) text_add(&t, "{\"id\":12345,\"name\":\"level\",\"ok\":false,\"child\":");
+    text_add(&t, "null");
+    for (j = 0; j < depth; ++j) text_add(&t, "}");
+  }
+  text_add(&t, "]");
+  return t.buf;
+}
+
+static void bench_printer(void) {
+  char *telemetry = make_telemetry(50000), *nested = make_nested(200, 100);
+  section("printer");
+  bench_print_mode("print telemetry", telemetry, 0, 0);
+  bench_print_mode("print telemetry buffered", telemetry, 0, 256);
+  bench_print_mode("print telemetry fmt", telemetry, 1, 0);
+  bench_print_mode("print telemetry fmt buffered", telemetry, 1, 256);
+  bench_print_stream("print telemetry stream", telemetry, 0);
+  bench_print_stream("print telemetry fmt stream", telemetry, 1);
+  bench_print_mode("print nested", nested, 0, 0);
+  bench_print_mode("print nested buffered", nested, 0, 256);
+  free(telemetry);
+  free(nested);
+}
+
+static void bench_numbers(void) {
+  char *ints = make_integers(200000), *doubles = make_doubles(200000), *telemetry = make_telemetry(50000);
+  char *formatted = make_formatted(telemetry);
+  section("numbers");
+  bench_parse("parse integers", ints);
+  bench_parse("parse doubles", doubles);
+  bench_parse("parse telemetry", telemetry);
+  bench_parse("parse telemetry formatted", formatted);
+  bench_push("parse telemetry push 4KB", telemetry, 4096);
+  bench_sax("parse telemetry sax", telemetry);
+  bench_parse_opts("parse telemetry lazy", telemetry, cjson_Option_Lazy);
+  bench_parse_pool("parse telemetry pool", telemetry);
+  bench_print("print integers", ints);
+  bench_print("print doubles", doubles);
+  bench_print("print telemetry", telemetry);
+  free(ints);
+  free(doubles);
+  free(telemetry);
+  free(formatted);
+}
+
+/*语料：一个有count个键的对象，值是各种类型的标量*/
+static char *make_wide(int count) {
+  text t = {0};
+  char rec[64];
+  int i;
+  text_add(&t, "{");
+  for (i = 0; i < count; ++i) {
+    switch (i % 4) {
+    case 0: sprintf(rec, "%s\"field_%06d\":%d", i ? "," : "", i, (int)(next_rand() % 100000)); break;
+    case 1: sprintf(rec, ",\"Field_%06d\":\"v%llx\"", i, next_rand() % 0xFFFFFF); break;
+    case 2: sprintf(rec, ",\"FIELD_%06d\":%s", i, (next_rand() & 1) ? "true" : "null"); break;
+    default: sprintf(rec, ",\"field_%06d_x\":%.3f", i, (double)(next_rand() % 100000) / 1000.0); break;
+    }
+    text_add(&t, rec);
+  }
+  text_add(&t, "}");
+  return t.buf;
+}
+
+/*树的操作：宽对象、深嵌套上的解析、查找、复制和释放*/
+static void bench_trees(void) {
+  char *wide = make_wide(100000), *nested = make_nested(200, 100), *telemetry = make_telemetry(50000);
+  section("tree");
+  bench_parse("parse wide", wide);
+  bench_parse("parse nested", nested);
+  bench_lookup("lookup wide", wide, 0);
+  bench_lookup("lookup wide case sensitive", wide, 1);
+  bench_tree("wide", wide);
+  bench_tree("nested", nested);
+  bench_tree("telemetry", telemetry);
+  free(wide);
+  free(nested);
+  free(telemetry);
+}
+
+/*线程数从1加倍到16，看能不能接近线性地变快*/
+static void bench_parallel_all(void) {
+  char *telemetry = make_telemetry(200000), *ndjson = make_ndjson(telemetry);
+  int threads;
+  section("parallel");
+  for (threads = 1; threads <= 16; threads *= 2) bench_parallel(telemetry, 0, threads);
+  for (threads = 1; threads <= 16; threads *= 2) bench_parallel(ndjson, 1, threads);
+  free(telemetry);
+  free(ndjson);
+}
+
+int main(int argc, char **argv) {
+  int i;
+  for (i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-j")) json_output = 1;
+    else rounds = atoi(argv[i]);
+  }
+  if (rounds <= 0) rounds = 1;
+  cjson_InitHooks(&count_hooks);
+  bench_numbers();
+  bench_strings();
+  bench_printer();
+  bench_trees();
+  bench_parallel_all();
+  if (!json_output) printf("peak RSS %ld KB\n", peak_rss_kb());
+  return 0;
+}
@@ -5,10 +5,49 @@
 #include <float.h>
 #include <limits.h>
 #include <ctype.h>
+#include <stdint.h>
 #include "cjson.h"
 
-static const char *ep;//错误指针
-const char *cjson_GetErrorPtr(void) {return ep;}
+/*字符串扫描的SIMD实现：x86上默认用SSE2，CPU支持时换成AVX2，编译时定义CJSON_NO_SIMD则只用逐字节的实现*/
+#if !defined(CJSON_NO_SIMD) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define CJSON_SIMD 1
+#include <immintrin.h>
+#endif
+
+/*并行解析用pthread，编译时定义CJSON_NO_THREADS或者没有pthread时在当前线程上依次解析各段*/
+#if !defined(CJSON_NO_THREADS) && (defined(__unix__) || defined(__APPLE__))
+#define CJSON_THREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/*统计：定义了CJSON_STATS时记到上下文挂着的cjson_Stats里，否则这些宏什么都不做*/
+#ifdef CJSON_STATS
+#include <time.h>
+static unsigned long long stats_now(void) {
+  struct timespec ts;
+#ifdef CLOCK_MONOTONIC
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+  timespec_get(&ts, TIME_UTC);
+#endif
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+#define stats_add(ctx, field, n) do { if ((ctx)->stats) (ctx)->stats->field += (n); } while (0)
+#define stats_depth(ctx, depth) do { if ((ctx)->stats && (depth) > (ctx)->stats->max_depth) (ctx)->stats->max_depth = (depth); } while (0)
+/*开始计时，没挂统计时不读时钟*/
+#define stats_start(ctx) ((ctx)->stats ? stats_now() : 0)
+#define stats_time(ctx, field, t0) do { if ((ctx)->stats) (ctx)->stats->field += stats_now() - (t0); } while (0)
+#else
+#define stats_add(ctx, field, n) ((void)0)
+#define stats_depth(ctx, depth) ((void)0)
+#define stats_start(ctx) 0ULL
+#define stats_time(ctx, field, t0) ((void)(t0))
+#endif
+
+/*默认上下文，cjson_Parse、cjson_InitHooks、cjson_GetErrorPtr等旧接口都作用在它上面*/
+static cjson_Context default_ctx = {{malloc, free}, 0, 0, 0, 0, cjson_Error_None, 0, 0};
+const char *cjson_GetErrorPtr(void) {return default_ctx.error_ptr;}
 /*忽略大小写，相等等于0，字符串比较,s1>s2输出大于0，否着小于0，如果只有一个字符指针指向NULL就1*/
 static int cjson_strcasecmp(const char *s1, const char *s2) {
   if (!s1) return (s1 == s2) ? 0 : 1;
@@ -17,1199 +56,4149 @@ static int cjson_strcasecmp(const char *s1, const char *s2) {
     if (*s1 == 0) return 0;
   return tolower(*(const unsigned char *)s1)-tolower(*(const unsigned char *)s2);
 }
-/*定义函数指针指向malloc和free*/
-static void *(*cjson_malloc)(size_t sz) = malloc;
-static void (*cjson_free)(void *ptr) = free;
+/*通过上下文的钩子分配和释放内存*/
+static void *cjson_malloc(cjson_Context *ctx, size_t sz) {
+  stats_add(ctx, allocs, 1);
+  stats_add(ctx, bytes, sz);
+  return ctx->hooks.malloc_fn(sz);
+}
+static void cjson_free(cjson_Context *ctx, void *ptr) {ctx->hooks.free_fn(ptr);}
 /*复制字符串*/
-static char* cjson_strdup(const char *str) {
+static char* cjson_strdup(cjson_Context *ctx, const char *str) {
   size_t len;
   char *copy;
 
   len = strlen(str) + 1;
-  if (!(copy = (char*)cjson_malloc(len))) return 0;//内存分配错误
+  if (!(copy = (char*)cjson_malloc(ctx, len))) return 0;//内存分配错误
   memcpy(copy, str, len);
   return copy;
 }
+/*初始化上下文，hooks为空时使用malloc和free*/
+void cjson_InitContext(cjson_Context *ctx, cjson_Hooks *hooks) {
+  if (!ctx) return;
+  ctx->hooks.malloc_fn = (hooks && hooks->malloc_fn)?hooks->malloc_fn:malloc;
+  ctx->hooks.free_fn   = (hooks && hooks->free_fn)?hooks->free_fn:free;
+  ctx->arena = 0;
+  ctx->options = 0;
+  ctx->max_depth = CJSON_NESTING_LIMIT;
+  ctx->error_ptr = 0;
+  ctx->error = cjson_Error_None;
+  ctx->stats = 0;
+  ctx->pool = 0;
+}
+int cjson_StatsEnabled(void) {
+#ifdef CJSON_STATS
+  return 1;
+#else
+  return 0;
+#endif
+}
+void cjson_InitStats(cjson_Stats *stats) {
+  default_ctx.stats = stats;
+  cjson_ResetStats();
+}
+void cjson_GetStatsWithContext(cjson_Context *ctx, cjson_Stats *out) {
+  if (!out) return;
+  if (ctx && ctx->stats) *out = *ctx->stats;
+  else memset(out, 0, sizeof(cjson_Stats));
+}
+void cjson_GetStats(cjson_Stats *out) {cjson_GetStatsWithContext(&default_ctx, out);}
+void cjson_ResetStatsWithContext(cjson_Context *ctx) {
+  if (ctx && ctx->stats) memset(ctx->stats, 0, sizeof(cjson_Stats));
+}
+void cjson_ResetStats(void) {cjson_ResetStatsWithContext(&default_ctx);}
 /*Hook内存管理函数*/
 void cjson_InitHooks(cjson_Hooks *hooks) {
   if (!hooks) {/*重置钩子*/
-    cjson_malloc = malloc;
-    cjson_free = free;
+    default_ctx.hooks.malloc_fn = malloc;
+    default_ctx.hooks.free_fn = free;
     return;
   }
 
-  cjson_malloc = (hooks->malloc_fn)?hooks->malloc_fn:malloc;
-  cjson_free   = (hooks->free_fn)?hooks->free_fn:free;
+  default_ctx.hooks.malloc_fn = (hooks->malloc_fn)?hooks->malloc_fn:malloc;
+  default_ctx.hooks.free_fn   = (hooks->free_fn)?hooks->free_fn:free;
 }
 
-static cjson *cjson_New_Item(void) {/*新建一个cjson项并返回该节点地址*/
-  cjson *node = (cjson*)cjson_malloc(sizeof(cjson));
-  if (node) memset(node, 0, sizeof(cjson));
-  return node;
+/*arena的一块内存，数据紧跟在块头之后*/
+typedef struct arena_chunk
+{
+  struct arena_chunk *next;
+  size_t size;/*数据区大小*/
+  size_t used;/*已经分配出去的字节数*/
+} arena_chunk;
+
+struct cjson_Arena
+{
+  arena_chunk *head;/*第一块*/
+  arena_chunk *current;/*正在分配的块*/
+  size_t chunk_size;/*新块的默认大小*/
+  cjson_Hooks hooks;/*创建时的钩子，防止中途换钩子*/
+};
+
+#define ARENA_ALIGN 8
+#define ARENA_DEFAULT_CHUNK (64 * 1024)
+#define ARENA_CHUNK_HEADER ((sizeof(arena_chunk) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+static arena_chunk *arena_new_chunk(cjson_Hooks *hooks, size_t size) {
+  arena_chunk *chunk = (arena_chunk *)hooks->malloc_fn(ARENA_CHUNK_HEADER + size);
+  if (!chunk) return 0;
+  chunk->next = 0;
+  chunk->size = size;
+  chunk->used = 0;
+  return chunk;
 }
 
-void cjson_Delete(cjson *c) {
-  cjson *next;
-  while (c) {
-    next = c->next;
-    //这里表示c不是一个引用类型是且1. c删儿子 2. c的值为字符串的释放字符串空间 3.不是常量释放键名
-    if (!(c->type&cjson_IsReference) && c->child) cjson_Delete(c->child);
-    if (!(c->type&cjson_IsReference) && c->valuestring) cjson_free(c->valuestring);
-    if (!(c->type&cjson_StringIsConst) && c->string) cjson_free(c->string);
-    cjson_free(c);
-    c = next;
+cjson_Arena *cjson_ArenaCreateWithContext(cjson_Context *ctx, size_t chunk_size) {
+  cjson_Arena *arena = (cjson_Arena *)cjson_malloc(ctx, sizeof(cjson_Arena));
+  if (!arena) return 0;
+  arena->chunk_size = chunk_size ? chunk_size : ARENA_DEFAULT_CHUNK;
+  arena->hooks = ctx->hooks;
+  arena->head = arena->current = arena_new_chunk(&arena->hooks, arena->chunk_size);
+  if (!arena->head) {
+    cjson_free(ctx, arena);
+    return 0;
   }
+  return arena;
 }
-/*解析文本转数字填充到这个项中*/
-static const char *parse_number(cjson *item, const char *num) {
-  double n=0, sign=1, scale=0;
-  int subscale=0, signsubscale=1;
-
-  if(*num == '-') sign=-1, ++num;
-  if (*num == '0') ++num;
-  if (*num>='1' && *num<='9') 
-    do n=(n*10.0)+(*num++ -'0');
-    while (*num>='0' && *num<='9');
-  if (*num == '.' && num[1]>='0' && num[1]<='9') {/*小数*/
-    ++num;
-    do n=(n*10)+(*num++ - '0'), --scale;
-    while (*num>='0' && *num<='9');
-  }
-  if (*num=='e' || *num=='E') {/*指数*/
-    ++num;
-    if (*num == '+') ++num;
-    else if (*num == '-') signsubscale=-1, ++num;
-    while (*num>='0' && *num<='9')
-      subscale=(subscale*10)+(*num++ - '0');
+cjson_Arena *cjson_ArenaCreate(size_t chunk_size) {return cjson_ArenaCreateWithContext(&default_ctx, chunk_size);}
+
+/*从arena中分配，当前块不够时先复用后面已有的块，再申请新块挂到当前块后面*/
+static void *cjson_ArenaAlloc(cjson_Arena *arena, size_t sz) {
+  arena_chunk *chunk = arena->current, *next;
+  sz = (sz + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+  while (chunk->size - chunk->used < sz) {
+    next = chunk->next;
+    if (next && next->size >= sz) {
+      next->used = 0;
+    }
+    else {
+      next = arena_new_chunk(&arena->hooks, sz > arena->chunk_size ? sz : arena->chunk_size);
+      if (!next) return 0;
+      next->next = chunk->next;
+      chunk->next = next;
+    }
+    arena->current = chunk = next;
   }
-  n = sign*n*pow(10.0,scale+signsubscale*subscale);
+  chunk->used += sz;
+  return (char *)chunk + ARENA_CHUNK_HEADER + chunk->used - sz;
+}
 
-  item->valuedouble = n;
-  item->valueint = (int)n;
-  item->type = cjson_Number;
-  return num;
+/*整体释放arena里的所有树，块保留下来给下一次解析用*/
+void cjson_ArenaReset(cjson_Arena *arena) {
+  if (!arena) return;
+  arena->current = arena->head;
+  arena->head->used = 0;
 }
 
-static int pow2gt(int x) {/*大于或等于的它的最接近它的2次幂数字*/
-  --x;
-  x |= x >> 1;
-  x |= x >> 2;
-  x |= x >> 4;
-  x |= x >> 8;
-  x |= x >> 16;
-  return x + 1;
+void cjson_ArenaDestroy(cjson_Arena *arena) {
+  arena_chunk *chunk, *next;
+  if (!arena) return;
+  for (chunk = arena->head; chunk; chunk = next) {
+    next = chunk->next;
+    arena->hooks.free_fn(chunk);
+  }
+  arena->hooks.free_fn(arena);
 }
 
-typedef struct 
+/*
+  节点池：块头后面紧跟slab_nodes个节点，空闲的节点用next串成链表。
+  共用的池每个线程有一个缓存，缓存属于哪个池用池的编号认，池的地址可能被新建的池重用；
+  换池和线程退出时把缓存还给原来的池，原来的池已经销毁时直接丢掉（节点随块一起释放了）
+*/
+typedef struct pool_slab
 {
-  char *buffer;/*内存字符串*/
-  int length;/*内存容量大小*/
-  int offset;/*偏移量*/
-} printbuffer;//输出缓冲
+  struct pool_slab *next;
+} pool_slab;
 
-/*缓冲内存分配，偏移量是与数组第一个元素的起始地址的距离可用于确定位置*/
-static char *ensure(printbuffer *p, int needed) {
-	char *newbuffer;
-	int newsize;
-	if (!p || !p->buffer)
-		return 0;
-	needed += p->offset;
-	if (needed <= p->length)
-		return p->buffer + p->offset;
-
-	newsize = pow2gt(needed);
-	newbuffer = (char *)cjson_malloc(newsize);
-	if (!newbuffer)
-	{
-		cjson_free(p->buffer);
-		p->length = 0, p->buffer = 0;
-		return 0;
-	}
-	if (newbuffer)
-		memcpy(newbuffer, p->buffer, p->length);
-	cjson_free(p->buffer);
-	p->length = newsize;
-	p->buffer = newbuffer;
-	return newbuffer + p->offset;
-}
-
-static int update(printbuffer *p) {/*相当于取出缓冲区字符串的长度*/
-  if (!p || !p->buffer) return 0;
-  char *str;
-  str = p->buffer + p->offset;
-  return p->offset + strlen(str);
-}
-/*数字转字符串*/
-static char *print_number(cjson *item, printbuffer *p) {
-  char *str = 0;
-  double d = item->valuedouble;
-  if (d == 0) {
-    if (p) str = ensure(p, 2);
-    else str = (char *)cjson_malloc(2);
-    if (str)
-      strcpy(str, "0");
-  }
-  else if (fabs(((double)item->valueint)-d) <= DBL_EPSILON && d <= INT_MAX && d >= INT_MIN) {
-    if (p)/*21是2^64-1的位数*/
-      str = ensure(p, 21);
-    else str = (char *)cjson_malloc(21);
-    if (str)
-      sprintf(str, "%d", item->valueint);
+#define POOL_DEFAULT_NODES 1024
+#define POOL_SLAB_HEADER ((sizeof(pool_slab) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+struct cjson_Pool
+{
+  cjson_Hooks hooks;/*创建时的钩子*/
+  pool_slab *slabs;
+  cjson *free;/*空闲节点*/
+  size_t slab_nodes;
+  int shared;
+#ifdef CJSON_THREADS
+  unsigned long id;/*共用的池的编号，不会重复*/
+  struct cjson_Pool *next_shared;/*所有还在的共用的池*/
+  pthread_mutex_t lock;
+#endif
+};
+
+#if defined(CJSON_THREADS) && (defined(__GNUC__) || defined(__clang__))
+#define POOL_CACHE 64/*每个线程缓存的节点数，空了从池里取一半，满了还回去一半*/
+typedef struct
+{
+  cjson_Pool *pool;
+  unsigned long id;
+  int count;
+  cjson *nodes[POOL_CACHE];
+} pool_cache;
+static __thread pool_cache thread_cache;
+static pthread_key_t pool_cache_key;/*只用它的析构函数：线程退出时把缓存还给池*/
+static int pool_cache_key_made;
+#endif
+#ifdef CJSON_THREADS
+static pthread_mutex_t shared_pools_lock = PTHREAD_MUTEX_INITIALIZER;
+static cjson_Pool *shared_pools;
+static unsigned long shared_pools_id;
+#endif
+
+/*新加一块，把它的节点都放进空闲链表*/
+static int pool_grow(cjson_Pool *pool) {
+  pool_slab *slab;
+  cjson *nodes;
+  size_t i;
+  if (pool->slab_nodes > (((size_t)-1) - POOL_SLAB_HEADER) / sizeof(cjson)) return 0;
+  slab = (pool_slab *)pool->hooks.malloc_fn(POOL_SLAB_HEADER + pool->slab_nodes * sizeof(cjson));
+  if (!slab) return 0;
+  slab->next = pool->slabs;
+  pool->slabs = slab;
+  nodes = (cjson *)((char *)slab + POOL_SLAB_HEADER);
+  for (i = pool->slab_nodes; i-- > 0;) {
+    nodes[i].next = pool->free;
+    pool->free = &nodes[i];
   }
-  else {
-    if (p)
-      str = ensure(p, 64);
-    else 
-      str = (char *)cjson_malloc(64);
-    if (str) {
-      if (fabs(floor(d)-d) <= DBL_EPSILON && fabs(d) < 1.0e60)
-        sprintf(str, "%.0f", d);
-      else if (fabs(d) < 1.0e-6 || fabs(d) > 1.0e9)
-        sprintf(str, "%e", d);//指数输出
-      else 
-        sprintf(str, "%f", d);
+  return 1;
+}
+/*从空闲链表取一个节点，共用的池要先加锁*/
+static cjson *pool_take(cjson_Pool *pool) {
+  cjson *node;
+  if (!pool->free && !pool_grow(pool)) return 0;
+  node = pool->free;
+  pool->free = node->next;
+  return node;
+}
+
+#ifdef POOL_CACHE
+/*把本线程缓存的节点还给原来的池，池已经销毁时丢掉*/
+static void pool_cache_flush(pool_cache *cache) {
+  cjson_Pool *pool;
+  if (cache->count) {
+    pthread_mutex_lock(&shared_pools_lock);/*拿着这个锁时池不会被销毁*/
+    for (pool = shared_pools; pool && (pool != cache->pool || pool->id != cache->id); pool = pool->next_shared);
+    if (pool) {
+      pthread_mutex_lock(&pool->lock);
+      while (cache->count) {
+        cache->nodes[--cache->count]->next = pool->free;
+        pool->free = cache->nodes[cache->count];
+      }
+      pthread_mutex_unlock(&pool->lock);
     }
+    pthread_mutex_unlock(&shared_pools_lock);
   }
-  return str;
+  cache->count = 0;
 }
-/*解析4位16进制*/
+static void pool_cache_exit(void *cache) {
+  pool_cache_flush((pool_cache *)cache);
+}
+/*本线程的缓存换成pool的，并登记线程退出时还回去（并行解析和后台删除的线程、调用者的线程都一样）*/
+static pool_cache *pool_cache_get(cjson_Pool *pool) {
+  pool_cache *cache = &thread_cache;
+  if (cache->pool != pool || cache->id != pool->id) {
+    pool_cache_flush(cache);
+    cache->pool = pool;
+    cache->id = pool->id;
+    if (pool_cache_key_made) pthread_setspecific(pool_cache_key, cache);
+  }
+  return cache;
+}
+#endif
 
-static unsigned parse_hex4(const char *str) {
-  unsigned h = 0;
-  for (int i = 0; i < 3; ++i, ++str, h<<=4) {
-    if (*str >= '0' && *str <= '9')
-      h += (*str) - '0';
-    else if (*str >= 'A' && *str <= 'F')
-      h += 10 + (*str) - 'A';
-    else if (*str >= 'a' && *str <= 'f')
-      h += 10 + (*str) - 'a';
-    else return 0;
+static cjson *pool_get(cjson_Pool *pool) {
+#ifdef CJSON_THREADS
+  cjson *node;
+#endif
+#ifdef POOL_CACHE
+  pool_cache *cache;
+#endif
+  if (!pool->shared) return pool_take(pool);
+#ifdef POOL_CACHE
+  cache = pool_cache_get(pool);
+  if (!cache->count) {
+    pthread_mutex_lock(&pool->lock);
+    while (cache->count < POOL_CACHE / 2 && (node = pool_take(pool))) cache->nodes[cache->count++] = node;
+    pthread_mutex_unlock(&pool->lock);
+    if (!cache->count) return 0;
   }
-  if (*str >= '0' && *str <= '9')
-    h += (*str) - '0';
-  else if (*str >= 'A' && *str <= 'F')
-    h += 10 + (*str) - 'A';
-  else if (*str >= 'a' && *str <= 'f')
-    h += 10 + (*str) - 'a';
-  else return 0;
-  return h;
+  return cache->nodes[--cache->count];
+#elif defined(CJSON_THREADS)
+  pthread_mutex_lock(&pool->lock);
+  node = pool_take(pool);
+  pthread_mutex_unlock(&pool->lock);
+  return node;
+#else
+  return pool_take(pool);
+#endif
+}
+static void pool_put(cjson_Pool *pool, cjson *node) {
+#ifdef POOL_CACHE
+  pool_cache *cache;
+#endif
+  if (!pool->shared) {
+    node->next = pool->free;
+    pool->free = node;
+    return;
+  }
+#ifdef POOL_CACHE
+  cache = pool_cache_get(pool);
+  if (cache->count == POOL_CACHE) {
+    pthread_mutex_lock(&pool->lock);
+    while (cache->count > POOL_CACHE / 2) {
+      cache->nodes[--cache->count]->next = pool->free;
+      pool->free = cache->nodes[cache->count];
+    }
+    pthread_mutex_unlock(&pool->lock);
+  }
+  cache->nodes[cache->count++] = node;
+#elif defined(CJSON_THREADS)
+  pthread_mutex_lock(&pool->lock);
+  node->next = pool->free;
+  pool->free = node;
+  pthread_mutex_unlock(&pool->lock);
+#else
+  node->next = pool->free;
+  pool->free = node;
+#endif
 }
 
-/*解析输入文本(未转义的字符串)，和填充项*/
-static const unsigned char firstByteMark[7] = {0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
-static const char *parse_string(cjson *item, const char *str) {
-  const char *ptr = str + 1;
-  char *ptr2;
-  char *out;
-  int len = 0;
-  unsigned uc, uc2;
-  if (*str != '\"') {
-    ep = str;
+cjson_Pool *cjson_PoolCreateWithContext(cjson_Context *ctx, size_t slab_nodes, int flags) {
+  cjson_Pool *pool;
+  if (!ctx || !(pool = (cjson_Pool *)cjson_malloc(ctx, sizeof(cjson_Pool)))) return 0;
+  memset(pool, 0, sizeof(cjson_Pool));
+  pool->hooks = ctx->hooks;
+  pool->slab_nodes = slab_nodes ? slab_nodes : POOL_DEFAULT_NODES;
+#ifdef CJSON_THREADS
+  if ((flags & cjson_Pool_Shared) && !pthread_mutex_init(&pool->lock, 0)) {
+    pool->shared = 1;
+    pthread_mutex_lock(&shared_pools_lock);
+#ifdef POOL_CACHE
+    if (!pool_cache_key_made) pool_cache_key_made = !pthread_key_create(&pool_cache_key, pool_cache_exit);
+#endif
+    pool->id = ++shared_pools_id;
+    pool->next_shared = shared_pools;
+    shared_pools = pool;
+    pthread_mutex_unlock(&shared_pools_lock);
+  }
+  else if (flags & cjson_Pool_Shared) {
+    cjson_free(ctx, pool);
     return 0;
   }
+#else
+  (void)flags;/*只有一个线程*/
+#endif
+  return pool;
+}
+cjson_Pool *cjson_PoolCreate(size_t slab_nodes, int flags) {return cjson_PoolCreateWithContext(&default_ctx, slab_nodes, flags);}
+void cjson_PoolDestroy(cjson_Pool *pool) {
+  pool_slab *slab, *next;
+#ifdef CJSON_THREADS
+  cjson_Pool **link;
+#endif
+  if (!pool) return;
+#ifdef CJSON_THREADS
+  if (pool->shared) {
+    pthread_mutex_lock(&shared_pools_lock);
+    for (link = &shared_pools; *link != pool; link = &(*link)->next_shared);
+    *link = pool->next_shared;
+    pthread_mutex_unlock(&shared_pools_lock);
+    pthread_mutex_destroy(&pool->lock);
+#ifdef POOL_CACHE
+    if (thread_cache.pool == pool) thread_cache.count = 0, thread_cache.pool = 0;
+#endif
+  }
+#endif
+  if (default_ctx.pool == pool) default_ctx.pool = 0;
+  for (slab = pool->slabs; slab; slab = next) {
+    next = slab->next;
+    pool->hooks.free_fn(slab);
+  }
+  pool->hooks.free_fn(pool);
+}
+void cjson_InitPool(cjson_Pool *pool) {default_ctx.pool = pool;}
 
-  while (*ptr != '\"' && *ptr && ++len) /*记录除转义字符外完整应的字符个数*/
-    if (*ptr++ == '\\')
-      ++ptr;
-  // printf("%d\n", len);
-  out = (char *)cjson_malloc(len + 1);
-  if (!out) return 0;
-  
-  ptr = str+1;
-  ptr2 = out;
-  while (*ptr != '\"' && *ptr) {
-    if (*ptr != '\\')
-      *ptr2++ = *ptr++;
-    else {
-      ++ptr;
-      switch (*ptr) {
-      case 'b':
-        *ptr2++ = '\b';
-        break;
-      case 'f':
-        *ptr2++ = '\f';
-        break;
-      case 'n':
-        *ptr2++ = '\n';
-        break;
-      case 'r':
-        *ptr2++ = '\r';
-        break;
-      case 't':
-        *ptr2++ = '\t';
-        break;
-      case 'u':
-        uc = parse_hex4(ptr+1);
-        ptr += 4;
-
-        if ((uc >= 0xDC00 && uc <= 0xDFFF) || uc == 0) break;
-        if (uc >= 0xD800 && uc <= 0xDBFF)/*UTF16 代理对*/ {
-          if (ptr[1] != '\\' || ptr[2] != 'u') break;/*缺少下半部分*/
-          uc2 = parse_hex4(ptr+3);
-          ptr += 6;
-          if (uc2 < 0xDC00 || uc2 > 0xDFFF) break;
-          uc = 0x10000 + (((uc & 0x3FF) << 10) | (uc2 & 0x3FF));
-
-        }
-
-        len = 4;
-        if (uc < 0x80) len = 1;
-        else if (uc < 0x800)  len = 2;
-        else if (uc < 0x10000) len = 3;
-        ptr2 += len;
-				switch (len)
-				{
-				case 4:
-					*--ptr2 = ((uc | 0x80) & 0xBF);
-					uc >>= 6;
-				case 3:
-					*--ptr2 = ((uc | 0x80) & 0xBF);
-					uc >>= 6;
-				case 2:
-					*--ptr2 = ((uc | 0x80) & 0xBF);
-					uc >>= 6;
-				case 1:
-					*--ptr2 = (uc | firstByteMark[len]);
-				}
-        ptr2 += len;
-        break;
-      default :
-        *ptr2++ = *ptr;
-        break;
-      }
-      ++ptr;
-    }
+/*新建一个cjson项并返回该节点地址，上下文带arena时从arena中分配并打上cjson_IsArena标志，
+带节点池时从池中分配并打上cjson_IsPooled标志，所以给新节点设置类型都用|=*/
+static cjson *cjson_New_Item(cjson_Context *ctx) {
+  cjson *node;
+  int type = 0;
+  stats_add(ctx, nodes, 1);
+  if (ctx->arena) {
+    stats_add(ctx, arena_bytes, sizeof(cjson));
+    node = (cjson *)cjson_ArenaAlloc(ctx->arena, sizeof(cjson));
+    type = cjson_IsArena;
   }
-  *ptr2 = 0;
-  if (*ptr == '\"')
-    ++ptr;
-  
-  item->valuestring = out;
-  item->type = cjson_String;
-  // puts(out);
-  return ptr;
+  else if (ctx->pool) {
+    node = pool_get(ctx->pool);
+    type = cjson_IsPooled;
+  }
+  else node = (cjson*)cjson_malloc(ctx, sizeof(cjson));
+  if (node) {
+    memset(node, 0, sizeof(cjson));
+    node->type = type;
+  }
+  return node;
+}
+
+/*给节点复制字符串，和节点本身放在同一个地方*/
+static char *item_strdup(cjson_Context *ctx, cjson *item, const char *str) {
+  size_t len;
+  char *copy;
+  if (!(item->type & cjson_IsArena) || !ctx->arena) return cjson_strdup(ctx, str);
+  len = strlen(str) + 1;
+  stats_add(ctx, arena_bytes, len);
+  if (!(copy = (char *)cjson_ArenaAlloc(ctx->arena, len))) return 0;
+  memcpy(copy, str, len);
+  return copy;
 }
 
-/*输出这个item中的string*/
-static char *print_string_ptr(const char *str, printbuffer *p) {
-  const char *ptr;
-  char *ptr2, *out;
-  int len = 0, flag = 0;
-  unsigned char token;
 /*
-    局部变量说明：
-      1.ptr：指向参数传入的str字符串
-      2.ptr2：指向要输出的out字符串
-      3.out：输出字符串
-      4.len：输出字符串的长度，用于内存分配出输出字符串的空间大小
-      5.token：字符保存中间变量
+  容器的子项索引，挂在cjson.index上，按容器类型分两种：
+  1.对象：键名哈希索引，开放寻址（线性探测）。键名相同（忽略大小写）的项在探测序列中的先后
+    和在子链中的先后一致，所以查到的总是链上第一个。追加时直接插入，按键名摘除时打删除标记，
+    其它会打乱顺序的修改直接丢弃索引，下次查找再建。
+  2.数组：子项指针的连续数组，下标就是位置，插入删除用memmove维护。
+  arena中的索引不能扩容，需要扩容时直接丢弃。
 */
-  for (ptr = str; *ptr; ++ptr) 
-    flag |= ((*ptr > 0 && *ptr < 32) || (*ptr == '\"') || 
-    (*ptr == '\\')) ? 1 : 0;
-  if (!flag) {
-    len = ptr - str;
-    if (p) out = ensure(p, len + 3);
-    else out = (char *)cjson_malloc(len + 3);
-    if (!out ) return 0;
-    ptr2 = out;
-    *ptr2++ = '\"';
-    strcpy(ptr2, str);
-    ptr2[len] = '\"';
-    ptr2[len+1] = 0;
-    return out;
-  }
-
-  if (!str) {
-    if (p) out = ensure(p, 3);
-    else out = (char *)cjson_malloc(3);
-    if (!out) return 0;
-    strcpy(out, "\"\"");
-    return out;
-  }
-  ptr = str;
-  while ((token = *ptr) && ++len) {
-    if (strchr("\"\\\b\f\n\r\t", token))
-      ++len;
-    else if (token < 32) len += 5;            
-          /*
-            除了前面列出来的空白字符，其他的空白都+5的长度，
-            不知道为什么，应该与unicode编码有关
-            如：
-                "\uxxxx",u再加4个字符就是5个字符，前面解析字符的时候是这么解析的。
-          */
-    ++ptr;
-  }
+typedef struct
+{
+  cjson *item;/*0为空槽*/
+  unsigned hash;
+  unsigned len;/*键名长度，区分大小写查找时先比长度和哈希再memcmp*/
+} index_entry;
 
-  if (p) out = ensure(p, len+3);
-  else out = (char *) cjson_malloc(len + 3);
-  if (!out) return 0;
+struct cjson_index
+{
+  cjson_Hooks hooks;/*建索引用的钩子，free_fn为0表示在arena中*/
+  unsigned size;/*对象：槽数，是2的幂；数组：容量*/
+  unsigned used;/*对象：用掉的槽，包括删除标记；数组：子项个数*/
+  union
+  {
+    index_entry entries[1];
+    cjson *items[1];
+  } u;
+};
 
-  ptr2 = out;
-  ptr = str;
-  *ptr2++ = '\"';
-  while (*ptr) {
-    if ((unsigned char) *ptr > 31 && *ptr != '\"' && *ptr != '\\') 
-      *ptr2++ = *ptr++;
-      else {
-        *ptr2++ = '\\';
-        switch (token = *ptr++) 
-        {
-        case '\\':
-          *ptr2++ = '\\';
-          break;
-        case '\"':
-          *ptr2++ = '\"';
-          break;
-        case '\b':
-          *ptr2++ = 'b';
-          break;
-        case '\f':
-          *ptr2++ = 'f';
-          break;
-        case '\n':
-          *ptr2++ = 'n';
-          break;
-        case '\r':
-          *ptr2++ = 'r';
-          break;
-        case '\t':
-          *ptr2++ = 't';
-          break;
-        default:
-          sprintf(ptr2, "u%04x", token);
-          ptr2 += 5;
-          break;
-        }
-      }
+static char index_deleted;/*删除标记*/
+#define INDEX_DELETED ((cjson *)&index_deleted)
+/*数组的索引是下标数组，其它（对象）是哈希索引*/
+#define is_vector(parent) (((parent)->type & 255) == cjson_Array)
+
+/*忽略大小写的FNV-1a，和cjson_strcasecmp的比较规则一致，同时求出长度*/
+static unsigned key_hash(const char *s, unsigned *len) {
+  unsigned h = 2166136261u;
+  const char *p;
+  for (p = s; *p; ++p)
+    h = (h ^ (unsigned)tolower(*(const unsigned char *)p)) * 16777619u;
+  if (len) *len = (unsigned)(p - s);
+  return h;
+}
+
+static struct cjson_index *index_alloc(unsigned size, size_t elem, cjson_Hooks *hooks, cjson_Arena *arena) {
+  struct cjson_index *idx;
+  size_t bytes = sizeof(struct cjson_index) + (size - 1) * elem;
+  idx = (struct cjson_index *)(arena ? cjson_ArenaAlloc(arena, bytes) : hooks->malloc_fn(bytes));
+  if (!idx) return 0;
+  memset(idx, 0, bytes);
+  if (!arena) idx->hooks = *hooks;
+  idx->size = size;
+  return idx;
+}
+
+static void index_free(struct cjson_index *idx) {
+  if (idx && idx->hooks.free_fn) idx->hooks.free_fn(idx);
+}
+
+/*丢弃容器的索引*/
+static void index_drop(cjson *parent) {
+  index_free(parent->index);
+  parent->index = 0;
+}
+
+/*只插到空槽，不复用删除标记，保证同名项的先后次序*/
+static void index_insert(struct cjson_index *idx, cjson *item) {
+  unsigned h, i, len, mask = idx->size - 1;
+  if (!item->string) return;/*没有键名的项不进索引*/
+  h = key_hash(item->string, &len);
+  for (i = h & mask; idx->u.entries[i].item; i = (i + 1) & mask);
+  idx->u.entries[i].item = item;
+  idx->u.entries[i].hash = h;
+  idx->u.entries[i].len = len;
+  ++idx->used;
+}
+
+/*为容器建立索引，对象的装载率不超过一半，arena不为空时从arena分配*/
+static struct cjson_index *index_build(cjson *parent, cjson_Hooks *hooks, cjson_Arena *arena) {
+  struct cjson_index *idx;
+  unsigned size = 16, n = (unsigned)parent->count;
+  cjson *c;
+  if (is_vector(parent)) {
+    if (size < n) size = n;
+    if (!(idx = index_alloc(size, sizeof(cjson *), hooks, arena))) return 0;
+    for (c = parent->child; c; c = c->next)
+      idx->u.items[idx->used++] = c;
+    return idx;
   }
-  *ptr2++ = '\"';
-  *ptr2++ = 0;
-  return out;
+  while (size < n * 2) size <<= 1;
+  if (!(idx = index_alloc(size, sizeof(index_entry), hooks, arena))) return 0;
+  for (c = parent->child; c; c = c->next)
+    index_insert(idx, c);
+  return idx;
 }
-/*Invote print_string_ptr (which is useful) on an item.*/
-static char *print_string(cjson *item, printbuffer *p) {return print_string_ptr(item->valuestring, p);}
-/*提前声明原型*/
-static const char *parse_value(cjson *item, const char *value);
-static char *print_value(cjson *item, int depth, int fmt, printbuffer *p);
-static const char *parse_array(cjson *item, const char *value);
-static char *print_array(cjson *item, int depth, int fmt, printbuffer *p);
-static const char *parse_object(cjson *item, const char *value);
-static char *print_object(cjson *item, int depth, int fmt, printbuffer *p);
-
-/*跳过一些空字符*/
-static const char *skip(const char *in) {
-  while (in && *in && (unsigned char) *in <= 32) ++in;
-  // puts(in);
-  return in;
-} 
-/*创建一个根,并且填充
-require_null_terminated 是为了确保字符串必须以'\0'结尾
-若参数提供return_parse_end将返回json字符串解析完成之后的部分进行返回
-*/
-cjson *cjson_ParseWithOpts(const char *value, const char **return_parse_end, int require_null_terminated) {
-    /*
-    返回一个json结构的数据
-    局部变量说明：
-        1.end：当解析完真个字符串的时候，最后一个字符如果不是NULL，则代表这个输入的value的字符串
-                可能有问题；
-        2.c：cjson节点，也是所谓的根节点。
-    */
-  const char *end = 0;
-  cjson *c = cjson_New_Item();
-  ep = 0;
-  if (!c) return 0;//内存分配失败
-  end = parse_value(c, skip(value));
-  if (!end) {
-    cjson_Delete(c);
-    return 0;
-  }/*解析失败*/
-  if (require_null_terminated) {
-    end = skip(end);
-    if (*end) {/*空字符后没结束*/
-      cjson_Delete(c);
-      ep = end;
-      return 0;
-    }
+
+/*case_sensitive为真时按字节精确比较*/
+static cjson *index_find(struct cjson_index *idx, const char *string, int case_sensitive) {
+  unsigned len, h = key_hash(string, &len), i, mask = idx->size - 1;
+  index_entry *e;
+  for (i = h & mask; (e = &idx->u.entries[i])->item; i = (i + 1) & mask) {
+    if (e->item == INDEX_DELETED || e->hash != h) continue;
+    if (case_sensitive ? (e->len == len && !memcmp(e->item->string, string, len))
+                       : !cjson_strcasecmp(e->item->string, string))
+      return e->item;
   }
-  if (return_parse_end) *return_parse_end = end;
-  return c;
+  return 0;
 }
-/*默认不检查NULL终止符,cjson字符串的解析新建根*/
-cjson *cjson_Parse(const char *value) {return cjson_ParseWithOpts(value, 0, 0);}
 
-/*将cjson实例结构呈现为文本*/
-char *cjson_Print(cjson *item) {return print_value(item, 0, 1, 0); }
-char *cjson_PrintUnformatted(cjson *item) {return print_value(item, 0, 0, 0); }
+/*找到item所在的槽，没有返回0*/
+static index_entry *index_slot(struct cjson_index *idx, cjson *item) {
+  unsigned i, mask = idx->size - 1;
+  index_entry *e;
+  if (!item->string) return 0;
+  for (i = key_hash(item->string, 0) & mask; (e = &idx->u.entries[i])->item; i = (i + 1) & mask)
+    if (e->item == item) return e;
+  return 0;
+}
 
-/*创建提供输出缓冲区，减少内存的分配次数*/
-char *cjson_PrintBuffered(cjson *item, int prebuffer, int fmt) {
-  printbuffer p;
-  p.buffer = (char *) cjson_malloc(prebuffer);
-  p.length = prebuffer;
-  p.offset = 0;
-  return print_value(item, 0, fmt, &p);
-  return p.buffer;
+/*数组索引至少能再放一项，arena中的索引不能扩容就丢弃，返回是否还有索引*/
+static int vector_reserve(cjson *array) {
+  struct cjson_index *idx = array->index, *bigger;
+  if (idx->used < idx->size) return 1;
+  if (idx->hooks.free_fn)
+    bigger = index_alloc(idx->size * 2, sizeof(cjson *), &idx->hooks, 0);
+  else bigger = 0;
+  if (bigger) {
+    memcpy(bigger->u.items, idx->u.items, idx->used * sizeof(cjson *));
+    bigger->used = idx->used;
+  }
+  index_free(idx);
+  array->index = bigger;
+  return bigger != 0;
 }
-/*根据首字符的不同来决定采用哪种方式进行解析字符串*/
-static const char *parse_value(cjson *item, const char *value) {
-  if (!value) return 0;
-  if (!strncmp(value, "null", 4)) {
-    item->type = cjson_Null;
-    return value + 4;
+
+/*追加了item。对象的槽用到3/4时按当前大小重建*/
+static void index_append(cjson *parent, cjson *item) {
+  struct cjson_index *idx = parent->index;
+  if (is_vector(parent)) {
+    if (vector_reserve(parent)) parent->index->u.items[parent->index->used++] = item;
+    return;
   }
-  if (!strncmp(value, "false", 5)) {
-    item->type = cjson_False;
-    return value + 5;
+  if ((idx->used + 1) * 4 <= idx->size * 3) {
+    index_insert(idx, item);
+    return;
   }
-  if (!strncmp(value, "true", 4)) {
-    item->type = cjson_True;
-    return value + 4;  
+  if (!idx->hooks.free_fn) {/*arena中的索引不能扩容*/
+    parent->index = 0;
+    return;
   }
-  if (*value == '\"') 
-    return parse_string(item, value);
-  if (*value == '-' || (*value >= '0' && *value <= '9'))
-    return parse_number(item, value);
-  if (*value == '[') 
-    return parse_array(item, value);
-  if (*value == '{') 
-    return parse_object(item, value);
+  parent->index = index_build(parent, &idx->hooks, 0);
+  index_free(idx);
+}
 
-  ep = value;
-    return 0;
+/*item插到了第which项*/
+static void index_insert_at(cjson *parent, cjson *item, int which) {
+  struct cjson_index *idx;
+  if (!is_vector(parent)) {/*插在中间会打乱同名项的次序*/
+    index_drop(parent);
+    return;
+  }
+  if (!vector_reserve(parent)) return;
+  idx = parent->index;
+  memmove(idx->u.items + which + 1, idx->u.items + which, (idx->used - which) * sizeof(cjson *));
+  idx->u.items[which] = item;
+  ++idx->used;
 }
-/*以文本呈现一个值,根据item的类型来选这使用哪种方式进行数的输出格式*/
 
-static char *print_value(cjson *item, int depth, int fmt, printbuffer *p) {
-  char *out = 0;
-  // puts("print_value");//dug
-  if (!item) return 0;
-  if (p) {
-    switch ((item->type) & 255)
-    {
-    case cjson_Null:
-      out = ensure(p, 5);
-      if (out) strcpy(out, "null");
-      break;
-    case cjson_False :
-      out = ensure(p, 6);
-      if (out) strcpy(out, "false");
-      break;
-    case cjson_True:
-      out = ensure(p, 5);
-      if (out) strcpy(out, "True");
-      break;
-    case cjson_Number:
-      out = print_number(item, p);
-      break;
-    case cjson_String:
-      out = print_string(item, p);
-      break;
-    case cjson_Array:
-      out = print_array(item, depth, fmt, p);
-      break;
-    case cjson_Object:
-      out = print_object(item, depth, fmt, p);
-      break;
-    }
+/*c从容器中摘除，which为它的位置，不知道时传-1*/
+static void index_remove(cjson *parent, cjson *c, int which) {
+  struct cjson_index *idx = parent->index;
+  index_entry *e;
+  if (!is_vector(parent)) {
+    if ((e = index_slot(idx, c))) e->item = INDEX_DELETED;
+    return;
   }
-  else {
-    switch ((item->type) & 255) {
-    case cjson_Null:
-      out = cjson_strdup("null");
-      break;
-    case cjson_False :
-      out = cjson_strdup("false");
-      break;
-    case cjson_True:
-      out = cjson_strdup("True");
-      break;
-    case cjson_Number:
-      out = print_number(item, 0);
-      break;
-    case cjson_String:
-      out = print_string(item, 0);
-      break;
-    case cjson_Array:
-      out = print_array(item, depth, fmt, 0);
-      break;
-    case cjson_Object:
-      out = print_object(item, depth, fmt, 0);
-      break;
-    }
+  if (which < 0) {
+    index_drop(parent);
+    return;
   }
-  return out;
+  memmove(idx->u.items + which, idx->u.items + which + 1, (idx->used - which - 1) * sizeof(cjson *));
+  --idx->used;
 }
 
-/* 从输入中构建一个数组*/
-/*格式
-  [
-    [0,1,0],
-    [1,1,0],
-    [1,1,1];
-  ]
-    1.先检测到[
-    2.然后skip掉换行符，空白字符
-    3.parse_value从新检测字符串，也就能再次检测又是一个数组了[0,-1,0],
-    递归进入解析[0,-1,0],并解析出0，-1，保存在节点中
-    4.检测是否遇到','字符，如果遇到说明后面还有内容需要解析
-    5.循环解析接下来的内容
-*/
-static const char *parse_array(cjson *item, const char *value) {
-  cjson *child;
-  if (*value != '[') {
-    ep = value;
-    return 0;
+/*c被newitem替换，which为它的位置，不知道时传-1*/
+static void index_replace(cjson *parent, cjson *c, cjson *newitem, int which) {
+  index_entry *e;
+  if (is_vector(parent)) {
+    if (which < 0) index_drop(parent);
+    else parent->index->u.items[which] = newitem;
+    return;
   }
-  item->type = cjson_Array;
-  value = skip(value + 1);
-  if (*value == ']')
-    return value + 1;/*空数组*/
-  item->child = child = cjson_New_Item();
-  if (!item->child) return 0;/*内存分配失败*/
-  value = skip(parse_value(child, skip(value)));
-  if (!value) return 0;/*解析错误*/
-  while(*value == ',') {
-    cjson *new_item;
-    if (!(new_item = cjson_New_Item())) return 0;/*内存分配失败*/
-    child->next = new_item;
-    new_item->prev = child;
-    child = new_item;
-    value = skip(parse_value(child, skip(value+1)));
-    if (!value) return 0; /*同上*/
-  }
-  if (*value == ']')
-    return value + 1;/*数组结束的后一个字符*/
-  ep = value;
-  return 0;
+  /*键名一样时原地替换槽，否则丢弃索引*/
+  e = index_slot(parent->index, c);
+  if (e && newitem->string && !cjson_strcasecmp(c->string, newitem->string)) e->item = newitem;
+  else index_drop(parent);
 }
 
-/*将数组输出为文档格式*/
-static char *print_array(cjson *item, int depth, int fmt, printbuffer *p) {
-  /*局部变量说明
-    entries: 输出字符串数组，从节点中提取到字符串数组中
-    out:entries 字符串数组中得到字符串out
-    ptr: 指向out 得指针
-    ret: 函数执行结果的返回值
-    len: 字符串长度
-    child :儿子节点也就是当前操作节点
-    numentries: 统计entries 的个数
-    fail: 错误标志
-    fmt: 用来调整格式
-    tmplen: 临时字符串长度
-    i:遍历
-  */
-  char **entries, *out = 0, *ptr, *ret;
-  int len = 5, i = 0, numentries = 0, fail = 0;
-  size_t tmplen = 0;
-  cjson *child = item->child;
-
-  /*多少个数组*/
-  while (child) ++numentries, child = child->next;
-  /*显示处理numentries == 0*/
-  if (!numentries) {
-    if (p) out = ensure(p, 3);
-    else out = (char *) cjson_malloc(3);
-    if (out) strcpy(out, "[]");
-    return out;
-  }
-
-  if (p) {
-    /*合并输出数组*/
-    i = p->offset;
-    ptr = ensure(p, 1);
-    if (!ptr) return 0;
-    *ptr = '[';
-    p->offset++;
-    child = item->child;
-    while (child && !fail) {
-      print_value(child, depth+1, fmt, p);
-      p->offset = update(p);
-      if (child->next) {
-        len = fmt ? 2 : 1;
-        ptr = ensure(p, len + 1);
-        if (!ptr) return 0;
-        *ptr++ = ',';
-        if (fmt) *ptr++ = ' ';
-        *ptr = 0;
-        p->offset += len;
-      }
-      child = child->next;
-    }
-    ptr = ensure(p, 2);
-    if (!ptr) return 0;
-    *ptr++ = ']';
-    *ptr = 0;
-    out = (p->buffer) + i;
-  }
-  else {
-    /*分配一个数组保持数组值*/
-    entries = (char **)cjson_malloc(numentries * sizeof(char *));
-    if (!entries) return 0;
-    memset(entries, 0, numentries*sizeof(char *));
-    /*取出所有的结果*/
-    child = item->child;
-    while (child && !fail) {
-      ret = print_value(child, depth+1, fmt, 0);
-      entries[i++] = ret;
-      if (ret) len += strlen(ret)+2+(fmt ? 1 : 0);
-      else fail = 1;
-      child = child->next;
-    }
+/*解析状态，在各个parse函数之间传递*/
+typedef struct
+{
+  cjson_Context *ctx;
+  const char *end;/*输入的结束位置，所有读取都不能越过它*/
+  int depth;/*当前嵌套深度*/
+  int lazy;/*cjson_Option_Lazy：字符串和数字只记录原文的位置*/
+} parsebuffer;
 
-    if (!fail) out = (char *)cjson_malloc(len);
-    if (!out) fail = 1;
-    if (fail) {
-      for (i = 0; i < numentries; ++i)
-        if (entries[i]) cjson_free(entries[i]);
-      cjson_free(entries);
-      return 0;
-    }
-    /*构成输出数组*/
-    *out = '[';
-    ptr = out + 1;
-    *ptr = 0;
-    for (i = 0; i < numentries; ++i) {
-      tmplen = strlen(entries[i]);
-      memcpy(ptr, entries[i], tmplen);
-      ptr += tmplen;
-      if (i != numentries-1) {
-        *ptr++ = ',';
-        if (fmt) *ptr++ = ' ';
-        *ptr = 0;
-      }
-      cjson_free(entries[i]);
-    }
-    cjson_free(entries);
-    *ptr++ = ']';
-    *ptr++ = 0;
+/*p处至少还有n个字节可读*/
+#define can_read(pb, p, n) ((size_t)((pb)->end - (p)) >= (size_t)(n))
+/*读取p处的字符，到结尾时当作'\0'，和以'\0'结尾的字符串行为一致*/
+#define peek(pb, p) ((p) < (pb)->end ? *(p) : '\0')
+
+/*解析时分配内存*/
+static void *parse_malloc(parsebuffer *pb, size_t sz) {
+  if (pb->ctx->arena) {
+    stats_add(pb->ctx, arena_bytes, sz);
+    return cjson_ArenaAlloc(pb->ctx->arena, sz);
   }
-  return out;
-} 
+  return cjson_malloc(pb->ctx, sz);
+}
 
+/*记录错误位置和错误码，返回0让解析函数直接返回*/
+static const char *parse_error(parsebuffer *pb, const char *at, int error) {
+  pb->ctx->error_ptr = at;
+  pb->ctx->error = error;
+  return 0;
+}
 
-/*以文本建立对象，同上*/
 /*
-    以下数据为格式分析：
+  遍历用的栈：解析、输出和复制不递归，回到上一层要用的节点放在这里。
+  先用结构体里的inline_items，嵌套更深时才换成堆上的，每次翻倍；
+  这样调用栈的用量和嵌套深度无关，一般的文档也不用分配
+*/
+#define WALK_INLINE 32
+typedef struct
 {
-    "name":"jack(\"bee\") Nimble",
-    "format":{
-        "type":"rect",
-        "width":1920
-        }
+  cjson **items;
+  size_t size, top;
+  cjson *inline_items[WALK_INLINE];
+} walkstack;
+static void walk_init(walkstack *s) {
+  s->items = s->inline_items;
+  s->size = WALK_INLINE;
+  s->top = 0;
 }
-    1.检测到'{';
-    2.跳过空白字符，换行符；
-    3.通过parse_string获取name；
-    4.判断键值对表示符':';
-    5.通过parse_value获取对应value；
-    6.parse_value和前面的几个函数一样，是递归函数
-    7.通过while循环解析剩下的键值对
-*/
-static const char *parse_object(cjson *item, const char *value) {
-  cjson *child;
-  if (*value != '{') {
-    ep = value;
-    return 0;
+static int walk_push(walkstack *s, cjson *c, cjson_Context *ctx) {
+  cjson **bigger;
+  if (s->top == s->size) {
+    if (s->size > ((size_t)-1) / 2 / sizeof(cjson *)) return 0;
+    if (!(bigger = (cjson **)cjson_malloc(ctx, s->size * 2 * sizeof(cjson *)))) return 0;
+    memcpy(bigger, s->items, s->top * sizeof(cjson *));
+    if (s->items != s->inline_items) cjson_free(ctx, s->items);
+    s->items = bigger;
+    s->size *= 2;
   }
-  item->type = cjson_Object;
-  value = skip(value+1);
-  if (*value == '}')
-    return value+1;
-  item->child = child = cjson_New_Item();
-  if (!child) return 0;
-  value = skip(parse_string(child, skip(value)));
-  if (!value) return 0;
-  child->string = child->valuestring;
-  child->valuestring = 0;
-  if (*value != ':') {
-    ep = value;
-    return 0;
+  s->items[s->top++] = c;
+  return 1;
+}
+static void walk_free(walkstack *s, cjson_Context *ctx) {
+  if (s->items != s->inline_items) cjson_free(ctx, s->items);
+}
+
+/*
+  可以增长的缓冲（文档的节点池和字符串池、推式解析的暂存区和栈、SAX的暂存区、批量解析的读缓冲）：
+  把buf扩到至少能放need个elem大小的元素，每次翻倍。钩子没有realloc，只能申请新的再复制
+*/
+static int buffer_grow(cjson_Hooks *hooks, void **buf, size_t *cap, size_t need, size_t elem) {
+  size_t size = *cap ? *cap : 64;
+  void *bigger;
+  while (size < need) {
+    if (size > ((size_t)-1) / 2 / elem) return 0;
+    size *= 2;
   }
-  value = skip(parse_value(child, skip(value+1)));
-  //printf("%s\n", value);
-  if (!value) return 0;
-  while (*value == ',') {
-    cjson *new_item;
-    if (!(new_item = cjson_New_Item())) return 0;
-    child->next = new_item;
-    new_item->prev = child;
-    child = new_item;
-    value = skip(parse_string(child, skip(value+1)));
-    if (!value) return 0;
-    child->string = child->valuestring;
-    child->valuestring = 0;
-    if (*value != ':') {
-      ep = value;
-      return 0;
+  if (!(bigger = hooks->malloc_fn(size * elem))) return 0;
+  if (*buf) {
+    memcpy(bigger, *buf, *cap * elem);
+    hooks->free_fn(*buf);
+  }
+  *buf = bigger;
+  *cap = size;
+  return 1;
+}
+
+/*
+  先用调用者栈上的inline_items、深了才换到堆上的栈（SAX和紧凑文档遍历时用）：
+  满了时扩大，第一次申请堆上的并把inline_items复制过去，之后每次翻倍
+*/
+static int stack_grow(cjson_Hooks *hooks, void **items, size_t *size, void *inline_items, size_t elem) {
+  void *heap = 0;
+  size_t cap = 0;
+  if (*items != inline_items) return buffer_grow(hooks, items, size, *size + 1, elem);
+  if (!buffer_grow(hooks, &heap, &cap, *size + 1, elem)) return 0;
+  memcpy(heap, inline_items, *size * elem);
+  *items = heap;
+  *size = cap;
+  return 1;
+}
+
+/*释放一个节点自己的内存，不管子项*/
+static void delete_node(cjson_Context *ctx, cjson *c) {
+  //这里表示c不是一个引用类型是且1. c的值为字符串的释放字符串空间 2.不是常量释放键名
+  //arena中的节点和字符串由cjson_ArenaReset统一释放，但它下面可能挂着普通分配的子项
+  if (c->index) index_free(c->index);
+  if (!(c->type&(cjson_IsReference|cjson_IsArena|cjson_IsLazy)) && c->valuestring) cjson_free(ctx, c->valuestring);
+  if (!(c->type&(cjson_StringIsConst|cjson_IsArena)) && c->string) cjson_free(ctx, c->string);
+  if (c->type&cjson_IsPooled) {/*没挂池时留在池里*/
+    if (ctx->pool) pool_put(ctx->pool, c);
+  }
+  else if (!(c->type&cjson_IsArena)) cjson_free(ctx, c);
+}
+/*
+  删除c和它后面的兄弟。不递归也不分配内存：有子项的节点先不删，
+  借它的prev把它串到pending上，删完它的子链再回来删它和它后面的兄弟
+*/
+static void delete_list(cjson_Context *ctx, cjson *c) {
+  cjson *pending = 0, *next;
+  for (;;) {
+    while (c) {
+      if (!(c->type&cjson_IsReference) && c->child) {
+        c->prev = pending;
+        pending = c;
+        c = c->child;
+        continue;
+      }
+      next = c->next;
+      delete_node(ctx, c);
+      c = next;
+    }
+    if (!pending) return;
+    c = pending;
+    pending = c->prev;
+    next = c->next;
+    delete_node(ctx, c);
+    c = next;
+  }
+}
+void cjson_DeleteWithContext(cjson_Context *ctx, cjson *c) {
+  unsigned long long t0 = stats_start(ctx);
+  delete_list(ctx, c);
+  stats_add(ctx, deletes, 1);
+  stats_time(ctx, delete_ns, t0);
+}
+void cjson_Delete(cjson *c) {cjson_DeleteWithContext(&default_ctx, c);}
+
+/*
+  后台删除：交过来的树用根的prev串成一个单链表，不需要分配内存。
+  线程每次把整条链表拿走，解锁后逐棵删除
+*/
+struct cjson_Reclaimer
+{
+  cjson_Context ctx;/*调用者上下文的钩子，统计不在这个线程里记*/
+  cjson *pending;/*等着删除的树*/
+  int started;/*线程起来了*/
+  int stop;
+#ifdef CJSON_THREADS
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  pthread_t thread;
+#endif
+};
+#ifdef CJSON_THREADS
+static void *reclaim_thread(void *arg) {
+  cjson_Reclaimer *r = (cjson_Reclaimer *)arg;
+  cjson *list, *next;
+  pthread_mutex_lock(&r->lock);
+  for (;;) {
+    while (!r->pending && !r->stop) pthread_cond_wait(&r->wake, &r->lock);
+    if (!r->pending) break;/*要停下来，也删完了*/
+    list = r->pending;
+    r->pending = 0;
+    pthread_mutex_unlock(&r->lock);
+    for (; list; list = next) {
+      next = list->prev;
+      delete_list(&r->ctx, list);
     }
-    value = skip(parse_value(child, skip(value+1)));
-    if (!value) return 0;
+    pthread_mutex_lock(&r->lock);
   }
-  if (*value == '}')
-    return value+1;
-  ep = value;
+  pthread_mutex_unlock(&r->lock);
   return 0;
 }
+#endif
+cjson_Reclaimer *cjson_ReclaimerCreateWithContext(cjson_Context *ctx) {
+  cjson_Reclaimer *r;
+  if (!ctx || !(r = (cjson_Reclaimer *)cjson_malloc(ctx, sizeof(cjson_Reclaimer)))) return 0;
+  memset(r, 0, sizeof(cjson_Reclaimer));
+  r->ctx = *ctx;
+  r->ctx.arena = 0;
+  r->ctx.stats = 0;
+  if (r->ctx.pool && !r->ctx.pool->shared) r->ctx.pool = 0;/*节点留在池里，不在别的线程里动它*/
+#ifdef CJSON_THREADS
+  if (!pthread_mutex_init(&r->lock, 0)) {
+    if (!pthread_cond_init(&r->wake, 0)) {
+      r->started = !pthread_create(&r->thread, 0, reclaim_thread, r);
+      if (!r->started) pthread_cond_destroy(&r->wake);
+    }
+    if (!r->started) pthread_mutex_destroy(&r->lock);
+  }
+#endif
+  return r;
+}
+cjson_Reclaimer *cjson_ReclaimerCreate(void) {return cjson_ReclaimerCreateWithContext(&default_ctx);}
+void cjson_DeleteLater(cjson_Reclaimer *r, cjson *c) {
+  if (!c) return;
+  if (!r || !r->started) {/*没有后台线程，当场删除*/
+    delete_list(r ? &r->ctx : &default_ctx, c);
+    return;
+  }
+#ifdef CJSON_THREADS
+  pthread_mutex_lock(&r->lock);
+  c->prev = r->pending;
+  r->pending = c;
+  pthread_cond_signal(&r->wake);
+  pthread_mutex_unlock(&r->lock);
+#endif
+}
+void cjson_ReclaimerDestroy(cjson_Reclaimer *r) {
+  if (!r) return;
+#ifdef CJSON_THREADS
+  if (r->started) {
+    pthread_mutex_lock(&r->lock);
+    r->stop = 1;
+    pthread_cond_signal(&r->wake);
+    pthread_mutex_unlock(&r->lock);
+    pthread_join(r->thread, 0);
+    pthread_cond_destroy(&r->wake);
+    pthread_mutex_destroy(&r->lock);
+  }
+#endif
+  cjson_free(&r->ctx, r);
+}
+/*解析文本转数字填充到这个项中*/
+/*
+  数字解析：先把最多19位有效数字读成64位整数mantissa和十进制指数exp10，
+  1.没有小数和指数、又放得下的整数直接得到精确的valueint64；
+  2.mantissa不超过2^53、|exp10|<=22时乘除一次10的幂就是正确舍入的结果（Clinger快速路径）；
+  3.否则用Eisel-Lemire算法：乘上128位的10的幂近似值，能确定舍入方向时直接得到结果；
+  4.剩下的少数情况（有效数字太多、次正规数、恰好在两个double中间）交给strtod。
+*/
+static const double exact_pow10[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
 
-/*将对象输出为文档格式*/
-static char *print_object(cjson *item, int depth, int fmt, printbuffer *p) {
-    /*
-    item 0,1,0;item 0,0,0
-    局部变量说明：
-        1.entries：键值对value
-        2.names：键值对key；
-        3.out：指向输出的字符串
-        4.ptr：指向out输出的字符串
-        5.ret：执行函数时返回的字符串地址；
-        6.str：执行函数返回的字符串地址
-        7.len：字符串的长度
-        8.i：for循环用于计数的变量
-        9.j: for循环用于计数的变量
-        10.child：指向节点的指针。
-        11.fail输出出错时的标志
-        12.numenties：用于统计当前结构深度层次上的节点个数
-    */
-  // puts("print_object");//dug
-  char **entrise = 0, **names = 0;/*值得字符串数组，名字的字符串数组*/
-  char *out = 0, *ptr, *ret, *str;/**/
-  int len = 7, i = 0, j;
-  cjson *child = item->child;
-  int numentries = 0, fail = 0;
-  size_t tmplen = 0;
-  /*计算字符串组数*/
-  while (child) ++numentries, child = child->next;
-  // printf("item son number: %d\n", numentries);
-  /* 空对象类型*/
-  if (!numentries) {
-    if (p) out = ensure(p, fmt ? depth+4 : 3);
-    else out = (char *)cjson_malloc(fmt ? depth+4 : 3);
-    if (!out ) return 0;
-    ptr = out;
-    *ptr++ = '{';
-    if (fmt) {
-      *ptr++ = '\n';
-      for (i = 0; i < depth-1; ++i) *ptr++ = '\t';
+/*10的幂的128位尾数（向下截断，最高位为1），第i项是1e(i+POW10_MIN)*/
+#define POW10_MIN (-348)
+#define POW10_MAX 347
+static const uint64_t pow10_128[][2] = {
+  {0xFA8FD5A0081C0288ULL, 0x1732C869CD60E453ULL}, {0x9C99E58405118195ULL, 0x0E7FBD42205C8EB4ULL},
+  {0xC3C05EE50655E1FAULL, 0x521FAC92A873B261ULL}, {0xF4B0769E47EB5A78ULL, 0xE6A797B752909EF9ULL},
+  {0x98EE4A22ECF3188BULL, 0x9028BED2939A635CULL}, {0xBF29DCABA82FDEAEULL, 0x7432EE873880FC33ULL},
+  {0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL}, {0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL},
+  {0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL}, {0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL},
+  {0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL}, {0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL},
+  {0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL}, {0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL},
+  {0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL}, {0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL},
+  {0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL}, {0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL},
+  {0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL}, {0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL},
+  {0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL}, {0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL},
+  {0x84A57695FE98746DULL, 0x014BB630F7604B57ULL}, {0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL},
+  {0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL}, {0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL},
+  {0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL}, {0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL},
+  {0xFD00B897478238D0ULL, 0x8920B098955522B4ULL}, {0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL},
+  {0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL}, {0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL},
+  {0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL}, {0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL},
+  {0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL}, {0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL},
+  {0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL}, {0xEBA09271E88D976BULL, 0xF7864A44C633682EULL},
+  {0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL}, {0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL},
+  {0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL}, {0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL},
+  {0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL}, {0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL},
+  {0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL}, {0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL},
+  {0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL}, {0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL},
+  {0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL}, {0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL},
+  {0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL}, {0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL},
+  {0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL}, {0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL},
+  {0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL}, {0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL},
+  {0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL}, {0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL},
+  {0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL}, {0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL},
+  {0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL}, {0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL},
+  {0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL}, {0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL},
+  {0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL}, {0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL},
+  {0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL}, {0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL},
+  {0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL}, {0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL},
+  {0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL}, {0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL},
+  {0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL}, {0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL},
+  {0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL}, {0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL},
+  {0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL}, {0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL},
+  {0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL}, {0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL},
+  {0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL}, {0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL},
+  {0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL}, {0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL},
+  {0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL}, {0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL},
+  {0xC987434744AC874EULL, 0xA327FFB266B56220ULL}, {0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL},
+  {0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL}, {0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL},
+  {0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL}, {0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL},
+  {0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL}, {0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL},
+  {0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL}, {0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL},
+  {0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL}, {0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL},
+  {0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL}, {0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL},
+  {0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL}, {0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL},
+  {0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL}, {0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL},
+  {0xAECC49914078536DULL, 0x58FAE9F773886E18ULL}, {0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL},
+  {0x888F99797A5E012DULL, 0x6D8406C952429603ULL}, {0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL},
+  {0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL}, {0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL},
+  {0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL}, {0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL},
+  {0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL}, {0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL},
+  {0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL}, {0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL},
+  {0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL}, {0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL},
+  {0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL}, {0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL},
+  {0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL}, {0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL},
+  {0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL}, {0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL},
+  {0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL}, {0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL},
+  {0xB913179899F68584ULL, 0x28E2557B59846E3FULL}, {0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL},
+  {0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL}, {0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL},
+  {0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL}, {0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL},
+  {0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL}, {0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL},
+  {0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL}, {0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL},
+  {0xD77485CB25823AC7ULL, 0x7D633293366B828BULL}, {0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL},
+  {0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL}, {0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL},
+  {0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL}, {0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL},
+  {0xCD795BE870516656ULL, 0x67902E276C921F8BULL}, {0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL},
+  {0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL}, {0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL},
+  {0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL}, {0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL},
+  {0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL}, {0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL},
+  {0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL}, {0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL},
+  {0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL}, {0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL},
+  {0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL}, {0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL},
+  {0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL}, {0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL},
+  {0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL}, {0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL},
+  {0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL}, {0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL},
+  {0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL}, {0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL},
+  {0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL}, {0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL},
+  {0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL}, {0xD47487CC8470652BULL, 0x7647C3200069671FULL},
+  {0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL}, {0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL},
+  {0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL}, {0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL},
+  {0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL}, {0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL},
+  {0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL}, {0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL},
+  {0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL}, {0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL},
+  {0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL}, {0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL},
+  {0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL}, {0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL},
+  {0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL}, {0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL},
+  {0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL}, {0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL},
+  {0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL}, {0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL},
+  {0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL}, {0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL},
+  {0x8C974F7383725573ULL, 0x1E414218C73A13FBULL}, {0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL},
+  {0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL}, {0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL},
+  {0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL}, {0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL},
+  {0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL}, {0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL},
+  {0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL}, {0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL},
+  {0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL}, {0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL},
+  {0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL}, {0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL},
+  {0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL}, {0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL},
+  {0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL}, {0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL},
+  {0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL}, {0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL},
+  {0xBE89523386091465ULL, 0xF6BBB397F1135823ULL}, {0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL},
+  {0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL}, {0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL},
+  {0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL}, {0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL},
+  {0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL}, {0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL},
+  {0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL}, {0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL},
+  {0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL}, {0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL},
+  {0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL}, {0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL},
+  {0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL}, {0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL},
+  {0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL}, {0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL},
+  {0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL}, {0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL},
+  {0x811CCC668829B887ULL, 0x0806357D5A3F525FULL}, {0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL},
+  {0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL}, {0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL},
+  {0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL}, {0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL},
+  {0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL}, {0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL},
+  {0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL}, {0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL},
+  {0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL}, {0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL},
+  {0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL}, {0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL},
+  {0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL}, {0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL},
+  {0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL}, {0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL},
+  {0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL}, {0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL},
+  {0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL}, {0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL},
+  {0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL}, {0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL},
+  {0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL}, {0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL},
+  {0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL}, {0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL},
+  {0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL}, {0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL},
+  {0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL}, {0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL},
+  {0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL}, {0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL},
+  {0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL}, {0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL},
+  {0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL}, {0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL},
+  {0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL}, {0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL},
+  {0xED246723473E3813ULL, 0x290123E9AAB23B68ULL}, {0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL},
+  {0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL}, {0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL},
+  {0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL}, {0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL},
+  {0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL}, {0x8D590723948A535FULL, 0x579C487E5A38AD0EULL},
+  {0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL}, {0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL},
+  {0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL}, {0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL},
+  {0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL}, {0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL},
+  {0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL}, {0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL},
+  {0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL}, {0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL},
+  {0xCDB02555653131B6ULL, 0x3792F412CB06794DULL}, {0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL},
+  {0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL}, {0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL},
+  {0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL}, {0x9CED737BB6C4183DULL, 0x55464DD69685606BULL},
+  {0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL}, {0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL},
+  {0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL}, {0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL},
+  {0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL}, {0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL},
+  {0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL}, {0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL},
+  {0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL}, {0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL},
+  {0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL}, {0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL},
+  {0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL}, {0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL},
+  {0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL}, {0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL},
+  {0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL}, {0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL},
+  {0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL}, {0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL},
+  {0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL}, {0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL},
+  {0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL}, {0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL},
+  {0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL}, {0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL},
+  {0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL}, {0x9E74D1B791E07E48ULL, 0x775EA264CF55347DULL},
+  {0xC612062576589DDAULL, 0x95364AFE032A819DULL}, {0xF79687AED3EEC551ULL, 0x3A83DDBD83F52204ULL},
+  {0x9ABE14CD44753B52ULL, 0xC4926A9672793542ULL}, {0xC16D9A0095928A27ULL, 0x75B7053C0F178293ULL},
+  {0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6338ULL}, {0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E03ULL},
+  {0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF584ULL}, {0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E5ULL},
+  {0x9392EE8E921D5D07ULL, 0x3AFF322E62439FCFULL}, {0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C2ULL},
+  {0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B3ULL}, {0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A10ULL},
+  {0xB424DC35095CD80FULL, 0x538484C19EF38C94ULL}, {0xE12E13424BB40E13ULL, 0x2865A5F206B06FB9ULL},
+  {0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D3ULL}, {0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D748ULL},
+  {0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1BULL}, {0x89705F4136B4A597ULL, 0x31680A88F8953030ULL},
+  {0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3DULL}, {0xD6BF94D5E57A42BCULL, 0x3D32907604691B4CULL},
+  {0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B10FULL}, {0xA7C5AC471B478423ULL, 0x0FCF80DC33721D53ULL},
+  {0xD1B71758E219652BULL, 0xD3C36113404EA4A8ULL}, {0x83126E978D4FDF3BULL, 0x645A1CAC083126E9ULL},
+  {0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A3ULL}, {0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCCULL},
+  {0x8000000000000000ULL, 0x0000000000000000ULL}, {0xA000000000000000ULL, 0x0000000000000000ULL},
+  {0xC800000000000000ULL, 0x0000000000000000ULL}, {0xFA00000000000000ULL, 0x0000000000000000ULL},
+  {0x9C40000000000000ULL, 0x0000000000000000ULL}, {0xC350000000000000ULL, 0x0000000000000000ULL},
+  {0xF424000000000000ULL, 0x0000000000000000ULL}, {0x9896800000000000ULL, 0x0000000000000000ULL},
+  {0xBEBC200000000000ULL, 0x0000000000000000ULL}, {0xEE6B280000000000ULL, 0x0000000000000000ULL},
+  {0x9502F90000000000ULL, 0x0000000000000000ULL}, {0xBA43B74000000000ULL, 0x0000000000000000ULL},
+  {0xE8D4A51000000000ULL, 0x0000000000000000ULL}, {0x9184E72A00000000ULL, 0x0000000000000000ULL},
+  {0xB5E620F480000000ULL, 0x0000000000000000ULL}, {0xE35FA931A0000000ULL, 0x0000000000000000ULL},
+  {0x8E1BC9BF04000000ULL, 0x0000000000000000ULL}, {0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL},
+  {0xDE0B6B3A76400000ULL, 0x0000000000000000ULL}, {0x8AC7230489E80000ULL, 0x0000000000000000ULL},
+  {0xAD78EBC5AC620000ULL, 0x0000000000000000ULL}, {0xD8D726B7177A8000ULL, 0x0000000000000000ULL},
+  {0x878678326EAC9000ULL, 0x0000000000000000ULL}, {0xA968163F0A57B400ULL, 0x0000000000000000ULL},
+  {0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL}, {0x84595161401484A0ULL, 0x0000000000000000ULL},
+  {0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL}, {0xCECB8F27F4200F3AULL, 0x0000000000000000ULL},
+  {0x813F3978F8940984ULL, 0x4000000000000000ULL}, {0xA18F07D736B90BE5ULL, 0x5000000000000000ULL},
+  {0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL}, {0xFC6F7C4045812296ULL, 0x4D00000000000000ULL},
+  {0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL}, {0xC5371912364CE305ULL, 0x6C28000000000000ULL},
+  {0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL}, {0x9A130B963A6C115CULL, 0x3C7F400000000000ULL},
+  {0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL}, {0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL},
+  {0x96769950B50D88F4ULL, 0x1314448000000000ULL}, {0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL},
+  {0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL}, {0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL},
+  {0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL}, {0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL},
+  {0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL}, {0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL},
+  {0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL}, {0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL},
+  {0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL}, {0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL},
+  {0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL}, {0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL},
+  {0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL}, {0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL},
+  {0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL}, {0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL},
+  {0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL}, {0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL},
+  {0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL}, {0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL},
+  {0x9F4F2726179A2245ULL, 0x01D762422C946590ULL}, {0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL},
+  {0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL}, {0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL},
+  {0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL}, {0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL},
+  {0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL}, {0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL},
+  {0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL}, {0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL},
+  {0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL}, {0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL},
+  {0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL}, {0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL},
+  {0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL}, {0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL},
+  {0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL}, {0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL},
+  {0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL}, {0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL},
+  {0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL}, {0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL},
+  {0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL}, {0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL},
+  {0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL}, {0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL},
+  {0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL}, {0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL},
+  {0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL}, {0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL},
+  {0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL}, {0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL},
+  {0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL}, {0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL},
+  {0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL}, {0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL},
+  {0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL}, {0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL},
+  {0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL}, {0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL},
+  {0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL}, {0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL},
+  {0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL}, {0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL},
+  {0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL}, {0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL},
+  {0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL}, {0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL},
+  {0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL}, {0x884134FE908658B2ULL, 0x3109058D147FDCDDULL},
+  {0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL}, {0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL},
+  {0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL}, {0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL},
+  {0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL}, {0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL},
+  {0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL}, {0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL},
+  {0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL}, {0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL},
+  {0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL}, {0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL},
+  {0x9AE757596946075FULL, 0x3375788DE9B06958ULL}, {0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL},
+  {0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL}, {0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL},
+  {0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL}, {0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL},
+  {0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL}, {0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL},
+  {0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL}, {0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL},
+  {0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL}, {0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL},
+  {0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL}, {0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL},
+  {0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL}, {0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL},
+  {0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL}, {0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL},
+  {0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL}, {0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL},
+  {0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL}, {0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL},
+  {0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL}, {0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL},
+  {0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL}, {0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL},
+  {0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL}, {0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL},
+  {0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL}, {0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL},
+  {0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL}, {0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL},
+  {0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL}, {0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL},
+  {0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL}, {0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL},
+  {0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL}, {0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL},
+  {0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL}, {0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL},
+  {0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL}, {0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL},
+  {0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL}, {0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL},
+  {0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL}, {0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL},
+  {0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL}, {0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL},
+  {0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL}, {0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL},
+  {0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL}, {0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL},
+  {0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL}, {0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL},
+  {0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL}, {0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL},
+  {0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL}, {0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL},
+  {0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL}, {0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL},
+  {0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL}, {0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL},
+  {0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL}, {0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL},
+  {0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL}, {0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL},
+  {0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL}, {0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL},
+  {0x8FA475791A569D10ULL, 0xF96E017D694487BCULL}, {0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL},
+  {0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL}, {0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL},
+  {0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL}, {0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL},
+  {0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL}, {0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL},
+  {0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL}, {0x85C7056562757456ULL, 0xF6872D5667844E49ULL},
+  {0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL}, {0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL},
+  {0x82A45B450226B39CULL, 0xECC0024661173473ULL}, {0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL},
+  {0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL}, {0xFF290242C83396CEULL, 0x7E67047175A15271ULL},
+  {0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL}, {0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL},
+  {0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL}, {0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL},
+  {0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL}, {0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL},
+  {0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL}, {0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL},
+  {0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL}, {0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL},
+  {0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL}, {0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL},
+  {0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL}, {0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL},
+  {0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL}, {0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL},
+  {0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL}, {0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL},
+  {0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL}, {0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL},
+  {0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL}, {0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL},
+  {0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL}, {0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL},
+  {0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL}, {0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL},
+  {0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL}, {0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL},
+  {0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL}, {0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL},
+  {0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL}, {0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL},
+  {0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL}, {0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL},
+  {0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL}, {0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL},
+  {0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL}, {0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL},
+  {0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL}, {0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL},
+  {0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL}, {0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL},
+  {0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL}, {0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL},
+  {0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL}, {0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL},
+  {0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL}, {0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL},
+  {0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL}, {0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL},
+  {0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL}, {0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL},
+  {0x8533285C936B35DEULL, 0xD53A88958F87275FULL}, {0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL},
+  {0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL}, {0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL},
+  {0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL}, {0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL},
+  {0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL}, {0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL},
+  {0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL}, {0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL},
+  {0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL}, {0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL},
+  {0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL}, {0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL},
+  {0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL}, {0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL},
+  {0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL}, {0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL},
+  {0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL}, {0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL},
+  {0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL}, {0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL},
+  {0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL}, {0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL},
+  {0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL}, {0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL},
+  {0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL}, {0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL},
+  {0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL}, {0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL},
+  {0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL}, {0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL},
+  {0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL}, {0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL},
+  {0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL}, {0xA0555E361951C366ULL, 0xD7E105BCC332621FULL},
+  {0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL}, {0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL},
+  {0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL}, {0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL},
+  {0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL}, {0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL},
+  {0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL}, {0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL},
+  {0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL}, {0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL},
+  {0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL}, {0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL},
+  {0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL}, {0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL},
+  {0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL}, {0xB201833B35D63F73ULL, 0x2CD2CC6551E513DAULL},
+  {0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D1ULL}, {0x8B112E86420F6191ULL, 0xFB04AFAF27FAF782ULL},
+  {0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B563ULL}, {0xD94AD8B1C7380874ULL, 0x18375281AE7822BCULL},
+  {0x87CEC76F1C830548ULL, 0x8F2293910D0B15B5ULL}, {0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB22ULL},
+  {0xD433179D9C8CB841ULL, 0x5FA60692A46151EBULL}, {0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD333ULL},
+  {0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0800ULL}, {0xCF39E50FEAE16BEFULL, 0xD768226B34870A00ULL},
+  {0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL}, {0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD0ULL},
+  {0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC4ULL}, {0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B5ULL},
+  {0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D1ULL}, {0xC5A05277621BE293ULL, 0xC7098B7305241885ULL},
+  {0xF70867153AA2DB38ULL, 0xB8CBEE4FC66D1EA7ULL}, {0x9A65406D44A5C903ULL, 0x737F74F1DC043328ULL},
+  {0xC0FE908895CF3B44ULL, 0x505F522E53053FF2ULL}, {0xF13E34AABB430A15ULL, 0x647726B9E7C68FEFULL},
+  {0x96C6E0EAB509E64DULL, 0x5ECA783430DC19F5ULL}, {0xBC789925624C5FE0ULL, 0xB67D16413D132072ULL},
+  {0xEB96BF6EBADF77D8ULL, 0xE41C5BD18C57E88FULL}, {0x933E37A534CBAAE7ULL, 0x8E91B962F7B6F159ULL},
+  {0xB80DC58E81FE95A1ULL, 0x723627BBB5A4ADB0ULL}, {0xE61136F2227E3B09ULL, 0xCEC3B1AAA30DD91CULL},
+  {0x8FCAC257558EE4E6ULL, 0x213A4F0AA5E8A7B1ULL}, {0xB3BD72ED2AF29E1FULL, 0xA988E2CD4F62D19DULL},
+  {0xE0ACCFA875AF45A7ULL, 0x93EB1B80A33B8605ULL}, {0x8C6C01C9498D8B88ULL, 0xBC72F130660533C3ULL},
+  {0xAF87023B9BF0EE6AULL, 0xEB8FAD7C7F8680B4ULL}, {0xDB68C2CA82ED2A05ULL, 0xA67398DB9F6820E1ULL},
+  {0x892179BE91D43A43ULL, 0x88083F8943A1148CULL}, {0xAB69D82E364948D4ULL, 0x6A0A4F6B948959B0ULL},
+  {0xD6444E39C3DB9B09ULL, 0x848CE34679ABB01CULL}, {0x85EAB0E41A6940E5ULL, 0xF2D80E0C0C0B4E11ULL},
+  {0xA7655D1D2103911FULL, 0x6F8E118F0F0E2195ULL}, {0xD13EB46469447567ULL, 0x4B7195F2D2D1A9FBULL},
+};
+
+/*64位乘法的高64位放到hi，返回低64位*/
+static uint64_t mul64(uint64_t a, uint64_t b, uint64_t *hi) {
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 r = (unsigned __int128)a * b;
+  *hi = (uint64_t)(r >> 64);
+  return (uint64_t)r;
+#else
+  uint64_t al = a & 0xFFFFFFFF, ah = a >> 32, bl = b & 0xFFFFFFFF, bh = b >> 32;
+  uint64_t ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+  uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+  *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+  return (mid << 32) | (ll & 0xFFFFFFFF);
+#endif
+}
+
+/*Eisel-Lemire：man*10^exp10正确舍入成double，不能确定时返回0*/
+static int eisel_lemire(uint64_t man, int exp10, int neg, double *out) {
+  uint64_t x_hi, x_lo, y_hi, y_lo, merged_hi, merged_lo, bits, ret_man, ret_exp;
+  int clz = 0;
+  if (!man) {
+    *out = neg ? -0.0 : 0.0;
+    return 1;
+  }
+  if (exp10 < POW10_MIN || exp10 > POW10_MAX) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+  clz = __builtin_clzll(man);
+#else
+  if (!(man >> 32)) clz += 32;
+  while (!((man << clz) >> 63)) ++clz;
+#endif
+  man <<= clz;/*规格化*/
+  ret_exp = (uint64_t)(((217706 * exp10) >> 16) + 64 + 1023) - (uint64_t)clz;/*217706/65536约为log2(10)*/
+  x_lo = mul64(man, pow10_128[exp10 - POW10_MIN][0], &x_hi);
+  if ((x_hi & 0x1FF) == 0x1FF && x_lo + man < man) {/*低位可能进位，用表中的低64位再精确一些*/
+    y_lo = mul64(man, pow10_128[exp10 - POW10_MIN][1], &y_hi);
+    merged_hi = x_hi;
+    merged_lo = x_lo + y_hi;
+    if (merged_lo < x_lo) ++merged_hi;
+    if ((merged_hi & 0x1FF) == 0x1FF && merged_lo + 1 == 0 && y_lo + man < man) return 0;
+    x_hi = merged_hi;
+    x_lo = merged_lo;
+  }
+  bits = x_hi >> 63;
+  ret_man = x_hi >> (bits + 9);/*54位*/
+  ret_exp -= 1 ^ bits;
+  if (x_lo == 0 && (x_hi & 0x1FF) == 0 && (ret_man & 3) == 1) return 0;/*恰好在中间*/
+  ret_man += ret_man & 1;/*舍入到53位*/
+  ret_man >>= 1;
+  if (ret_man >> 53) {
+    ret_man >>= 1;
+    ++ret_exp;
+  }
+  if (ret_exp - 1 >= 0x7FF - 1) return 0;/*次正规数或者溢出*/
+  bits = (ret_exp << 52) | (ret_man & 0x000FFFFFFFFFFFFFULL);
+  if (neg) bits |= 0x8000000000000000ULL;
+  memcpy(out, &bits, sizeof(double));
+  return 1;
+}
+
+/*
+  慢路径交给strtod，输入的数字先改写到栈上的缓冲里，不申请内存：
+  只留前SLOW_DIGITS位有效数字，丢掉的部分不全是0时末尾补一个1，写成没有小数点的“有效数字e指数”。
+  两个相邻double的中点最多767位有效数字，这样截断不改变舍入方向；没有小数点也就不受locale影响
+*/
+#define SLOW_DIGITS 800
+static double slow_strtod(const char *start, const char *end) {
+  char buf[SLOW_DIGITS + 32], *o = buf;
+  const char *p = start;
+  long long exp10 = 0, e = 0;
+  int n = 0, in_fraction = 0, esign = 1, sticky = 0;
+  if (*p == '-') *o++ = *p++;
+  for (; p < end && *p != 'e' && *p != 'E'; ++p) {
+    if (*p == '.') in_fraction = 1;
+    else if (!n && *p == '0') exp10 -= in_fraction;/*前导0*/
+    else if (n < SLOW_DIGITS) {
+      *o++ = *p;
+      ++n;
+      exp10 -= in_fraction;
+    }
+    else {
+      if (*p != '0') sticky = 1;
+      exp10 += !in_fraction;
+    }
+  }
+  if (sticky) *o++ = '1', --exp10;
+  if (!n) *o++ = '0';
+  if (p < end) ++p;/*指数*/
+  if (p < end && (*p == '+' || *p == '-')) esign = *p++ == '-' ? -1 : 1;
+  for (; p < end; ++p)
+    if (e < 100000000) e = e * 10 + (*p - '0');
+  exp10 += esign * e;
+  if (exp10 > 100000000) exp10 = 100000000;/*有效数字不到SLOW_DIGITS+1位，这么大的指数一定溢出或者下溢*/
+  if (exp10 < -100000000) exp10 = -100000000;
+  sprintf(o, "e%lld", exp10);
+  return strtod(buf, 0);
+}
+
+/*double转成整数，超出范围时取最大或最小值*/
+static long long number_to_int64(double d) {
+  if (d >= 9223372036854775807.0) return LLONG_MAX;
+  if (d <= -9223372036854775808.0) return LLONG_MIN;
+  if (d != d) return 0;
+  return (long long)d;
+}
+
+/*设置数值，整数值取饱和*/
+static void number_set(cjson *item, double d, long long i) {
+  item->valuedouble = d;
+  item->valueint64 = i;
+  item->valueint = i > INT_MAX ? INT_MAX : (i < INT_MIN ? INT_MIN : (int)i);
+}
+
+/*惰性的数字设置后就不再是惰性的，否则取值时又会从原文转换，新值丢了*/
+double cjson_SetNumberHelper(cjson *object, double number) {
+  if ((object->type & 255) == cjson_Number && (object->type & cjson_IsLazy)) {
+    object->type &= ~cjson_IsLazy;
+    object->valuestring = 0;
+  }
+  number_set(object, number, number_to_int64(number));
+  return number;
+}
+
+static const char *parse_number(cjson *item, const char *num, parsebuffer *pb) {
+  const char *end = pb->end, *start = num, *digit_start, *p;
+  uint64_t man = 0;
+  int neg = 0, digits, dropped = 0, exp10 = 0, subscale = 0, signsubscale = 1, is_int = 1, in_fraction = 0;
+  double d, d2;
+
+  if(*num == '-') neg = 1, ++num;
+  digit_start = num;
+  if (num < end && *num == '0') ++num;
+  if (num < end && *num>='1' && *num<='9')
+    do man = man*10 + (uint64_t)(*num++ - '0');
+    while (num < end && *num>='0' && *num<='9');
+  digits = (int)(num - digit_start);
+  if (can_read(pb, num, 2) && *num == '.' && num[1]>='0' && num[1]<='9') {/*小数*/
+    p = ++num;
+    is_int = 0;
+    do man = man*10 + (uint64_t)(*num++ - '0');
+    while (num < end && *num>='0' && *num<='9');
+    exp10 = -(int)(num - p);
+    digits += (int)(num - p);
+  }
+  if (digits > 19) {/*man可能溢出了：跳过前导0重新读，只保留前19位有效数字，后面的只记指数*/
+    man = 0;
+    exp10 = digits = 0;
+    for (p = digit_start; p < num; ++p) {
+      if (*p == '.') in_fraction = 1;
+      else if (digits < 19) {
+        man = man*10 + (uint64_t)(*p - '0');
+        if (in_fraction) --exp10;
+        if (man) ++digits;/*前导0不算有效数字*/
+      }
+      else {
+        if (*p != '0') dropped = 1;
+        if (!in_fraction) ++exp10;
+      }
     }
-    *ptr++ = '}';
-    *ptr++ = 0;
-    return out;
-  }
-  if (p) {
-    i = p->offset;
-    len = fmt ? 2 : 1;
-    ptr = ensure(p, len+1);
-    if (!ptr) return 0;
-    *ptr++ = '{';
-    *ptr++ = '\n';
+  }
+  if (num < end && (*num=='e' || *num=='E')) {/*指数*/
+    ++num;
+    is_int = 0;
+    if (num < end && *num == '+') ++num;
+    else if (num < end && *num == '-') signsubscale=-1, ++num;
+    while (num < end && *num>='0' && *num<='9') {
+      if (subscale < 100000) subscale=(subscale*10)+(*num - '0');
+      ++num;
+    }
+  }
+  exp10 += signsubscale*subscale;
+
+  if (is_int && !exp10 && (man <= (uint64_t)LLONG_MAX || (neg && man == (uint64_t)LLONG_MAX + 1))) {
+    /*精确的64位整数*/
+    d = (double)man;
+    number_set(item, neg ? -d : d, neg ? -(long long)(man - 1) - 1 : (long long)man);
+    item->type |= cjson_Number;
+    return num;
+  }
+  if (!dropped && man <= ((uint64_t)1 << 53) && exp10 >= -22 && exp10 <= 22) {
+    d = (double)man;
+    d = exp10 < 0 ? d / exact_pow10[-exp10] : d * exact_pow10[exp10];
+    if (neg) d = -d;
+  }
+  else if (!eisel_lemire(man, exp10, neg, &d)
+           || (dropped && (!eisel_lemire(man + 1, exp10, neg, &d2) || d != d2)))/*丢了尾数时man和man+1舍入结果一样才算数*/
+    d = slow_strtod(start, num);
+
+  number_set(item, d, number_to_int64(d));
+  item->type |= cjson_Number;
+  return num;
+}
+
+/*
+  输出缓冲：所有输出函数都往offset处追加并把offset往后移，
+  不回头扫描已经写好的内容，整个输出只需要一遍。
+  设置了write时是流式输出：buffer是调用者给的固定大小的缓冲，写满了就交给write，不再增长
+*/
+typedef struct 
+{
+  char *buffer;/*内存字符串*/
+  size_t length;/*内存容量大小*/
+  size_t offset;/*已经写入的字节数，下一次从这里写*/
+  cjson_Context *ctx;/*分配缓冲用的上下文*/
+  cjson_WriteFn write;/*流式输出的回调*/
+  void *user;/*传给write的参数*/
+} printbuffer;//输出缓冲
+
+/*流式输出的缓冲最小要这么大，数字和缩进都不会拆开写*/
+#define PRINT_STREAM_MIN 64
+
+/*cjson_Print等不指定缓冲大小时的初始大小*/
+#define PRINT_DEFAULT_BUFFER 256
+
+/*
+  保证offset之后还有needed字节可写，返回写入的位置。
+  不够时容量翻倍，只复制已经写入的部分；分配失败时释放缓冲，之后的ensure都返回0
+*/
+/*把流式输出缓冲里的内容交给write，失败时buffer置空，之后的输出都失败*/
+static int print_flush(printbuffer *p) {
+  if (!p->buffer) return 0;
+  if (p->offset && !p->write(p->user, p->buffer, p->offset)) {
+    p->buffer = 0;
+    return 0;
+  }
+  p->offset = 0;
+  return 1;
+}
+
+static char *ensure(printbuffer *p, size_t needed) {
+  char *newbuffer;
+  size_t newsize;
+  if (!p->buffer) return 0;
+  if (needed + p->offset <= p->length) return p->buffer + p->offset;
+  if (p->write)/*流式输出：先写出去，缓冲还不够就只能由调用者分段写*/
+    return (print_flush(p) && needed <= p->length) ? p->buffer : 0;
+  needed += p->offset;
+
+  for (newsize = p->length ? p->length : 1; newsize < needed; newsize *= 2);
+  stats_add(p->ctx, buffer_grows, 1);
+  newbuffer = (char *)cjson_malloc(p->ctx, newsize);
+  if (newbuffer) memcpy(newbuffer, p->buffer, p->offset);
+  cjson_free(p->ctx, p->buffer);
+  p->buffer = newbuffer;
+  p->length = newbuffer ? newsize : 0;
+  return newbuffer ? newbuffer + p->offset : 0;
+}
+
+/*追加len个字节，流式输出时比缓冲还长的直接交给write*/
+static int print_append(printbuffer *p, const char *str, size_t len) {
+  char *out;
+  if (p->write && len > p->length) {
+    if (!print_flush(p)) return 0;
+    if (p->write(p->user, str, len)) return 1;
+    p->buffer = 0;
+    return 0;
+  }
+  if (!(out = ensure(p, len))) return 0;
+  memcpy(out, str, len);
+  p->offset += len;
+  return 1;
+}
+
+/*追加n个制表符的缩进，每次最多写PRINT_STREAM_MIN个*/
+static int print_indent(printbuffer *p, int n) {
+  char *out;
+  int len;
+  for (; n > 0; n -= len) {
+    len = n < PRINT_STREAM_MIN ? n : PRINT_STREAM_MIN;
+    if (!(out = ensure(p, len))) return 0;
+    memset(out, '\t', len);
     p->offset += len;
-    child = item->child;
-    ++depth;
-    while (child)
-    {
-      if (fmt) {
-        ptr = ensure(p, depth);
-        if (!ptr) return 0;
-        for (j = 0; j < depth; ++j)
-          *ptr++ = '\t';
-        p->offset += depth;
+  }
+  return 1;
+}
+/*
+  数字输出：能精确表示的64位整数直接按位输出；其它double用Grisu2算法求出能精确还原的最短数字串，
+  再排成普通小数或者指数形式。不经过sprintf，不受locale影响。
+*/
+typedef struct
+{
+  uint64_t f;
+  int e;/*值为f*2^e*/
+} diy_fp;
+
+static diy_fp diy_mul(diy_fp a, diy_fp b) {
+  diy_fp r;
+  uint64_t hi, lo = mul64(a.f, b.f, &hi);
+  r.f = hi + (lo >> 63);/*四舍五入*/
+  r.e = a.e + b.e + 64;
+  return r;
+}
+
+static diy_fp diy_normalize(diy_fp x) {
+  while (!(x.f >> 63)) x.f <<= 1, --x.e;
+  return x;
+}
+
+/*1e(q)的64位近似，取自pow10_128*/
+static diy_fp cached_pow10(int q) {
+  diy_fp c;
+  c.f = pow10_128[q - POW10_MIN][0] + (pow10_128[q - POW10_MIN][1] >> 63);
+  c.e = ((217706 * q) >> 16) - 63;
+  return c;
+}
+
+static const uint32_t pow10_32[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+static void grisu_round(char *buf, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w) {
+  while (rest < wp_w && delta - rest >= ten_kappa
+         && (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+    buf[len - 1]--;
+    rest += ten_kappa;
+  }
+}
+
+/*v>0且有限，数字放到buf，返回位数，值为buf*10^K*/
+static int grisu2(double v, char *buf, int *K) {
+  uint64_t bits, delta, p2, tmp;
+  uint32_t p1, d;
+  diy_fp w, wp, wm, c, one;
+  int biased, kappa, len = 0, q;
+
+  memcpy(&bits, &v, sizeof(double));
+  biased = (int)((bits >> 52) & 0x7FF);
+  w.f = bits & 0x000FFFFFFFFFFFFFULL;
+  if (biased) w.f |= 0x0010000000000000ULL, w.e = biased - 1075;
+  else w.e = 1 - 1075;
+  /*相邻两个double的中点是可以输出的范围*/
+  wp.f = (w.f << 1) + 1, wp.e = w.e - 1;
+  while (!(wp.f & (0x0010000000000000ULL << 1))) wp.f <<= 1, --wp.e;
+  wp.f <<= 10, wp.e -= 10;
+  if (w.f == 0x0010000000000000ULL) wm.f = (w.f << 2) - 1, wm.e = w.e - 2;
+  else wm.f = (w.f << 1) - 1, wm.e = w.e - 1;
+  wm.f <<= wm.e - wp.e, wm.e = wp.e;
+  w = diy_normalize(w);
+
+  /*选10的幂使乘积的指数落在[-60,-32]里*/
+  q = (int)ceil((-61 - wp.e) * 0.30102999566398114);
+  c = cached_pow10(q);
+  *K = -q;
+  w = diy_mul(w, c);
+  wp = diy_mul(wp, c);
+  wm = diy_mul(wm, c);
+  ++wm.f;
+  --wp.f;
+  delta = wp.f - wm.f;
+
+  one.f = (uint64_t)1 << -wp.e, one.e = wp.e;
+  p1 = (uint32_t)(wp.f >> -one.e);
+  p2 = wp.f & (one.f - 1);
+  for (kappa = 1; kappa < 10 && p1 >= pow10_32[kappa]; ++kappa);
+  while (kappa > 0) {/*整数部分*/
+    d = p1 / pow10_32[kappa - 1];
+    p1 %= pow10_32[kappa - 1];
+    if (d || len) buf[len++] = (char)('0' + d);
+    --kappa;
+    tmp = ((uint64_t)p1 << -one.e) + p2;
+    if (tmp <= delta) {
+      *K += kappa;
+      grisu_round(buf, len, delta, tmp, (uint64_t)pow10_32[kappa] << -one.e, wp.f - w.f);
+      return len;
+    }
+  }
+  while (1) {/*小数部分*/
+    p2 *= 10;
+    delta *= 10;
+    d = (uint32_t)(p2 >> -one.e);
+    if (d || len) buf[len++] = (char)('0' + d);
+    p2 &= one.f - 1;
+    --kappa;
+    if (p2 < delta) {
+      *K += kappa;
+      grisu_round(buf, len, delta, p2, one.f, (wp.f - w.f) * (-kappa < 10 ? pow10_32[-kappa] : 0));
+      return len;
+    }
+  }
+}
+
+static const char digit_pairs[201] =
+  "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+  "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+/*无符号整数按十进制写到out，返回长度*/
+static int write_uint64(char *out, uint64_t v) {
+  char tmp[20], *t = tmp + 20;
+  int len;
+  while (v >= 100) {
+    t -= 2;
+    memcpy(t, digit_pairs + (v % 100) * 2, 2);
+    v /= 100;
+  }
+  if (v >= 10) {
+    t -= 2;
+    memcpy(t, digit_pairs + v * 2, 2);
+  }
+  else *--t = (char)('0' + v);
+  len = (int)(tmp + 20 - t);
+  memcpy(out, t, len);
+  return len;
+}
+
+/*double写成最短的能精确还原的文本，out至少NUMBER_BUFFER字节，返回长度。NaN和无穷输出null*/
+#define NUMBER_BUFFER 32
+static int format_double(double d, char *out) {
+  char *o = out;
+  int len, K, kk, i;
+  if (d != d || d - d != 0) {
+    memcpy(out, "null", 5);
+    return 4;
+  }
+  if (signbit(d)) *o++ = '-', d = -d;
+  if (d == 0) {
+    *o++ = '0';
+    *o = 0;
+    return (int)(o - out);
+  }
+  len = grisu2(d, o, &K);
+  kk = len + K;/*10^(kk-1) <= d < 10^kk*/
+  if (K >= 0 && kk <= 21) {/*整数：1234e7 -> 12340000000*/
+    for (i = len; i < kk; ++i) o[i] = '0';
+    o += kk;
+  }
+  else if (kk > 0 && kk <= 21) {/*1234e-2 -> 12.34*/
+    memmove(o + kk + 1, o + kk, len - kk);
+    o[kk] = '.';
+    o += len + 1;
+  }
+  else if (kk > -6 && kk <= 0) {/*1234e-6 -> 0.001234*/
+    memmove(o + 2 - kk, o, len);
+    o[0] = '0';
+    o[1] = '.';
+    for (i = 2; i < 2 - kk; ++i) o[i] = '0';
+    o += len + 2 - kk;
+  }
+  else {/*1234e30 -> 1.234e+33*/
+    if (len > 1) {
+      memmove(o + 2, o + 1, len - 1);
+      o[1] = '.';
+      o += len + 1;
+    }
+    else ++o;
+    *o++ = 'e';
+    *o++ = (kk - 1 < 0) ? '-' : '+';
+    o += write_uint64(o, (uint64_t)(kk - 1 < 0 ? 1 - kk : kk - 1));
+  }
+  *o = 0;
+  return (int)(o - out);
+}
+
+/*数字转字符串*/
+static int print_number(cjson *item, printbuffer *p) {
+  char *str = ensure(p, NUMBER_BUFFER);
+  double d = item->valuedouble;
+  long long i = item->valueint64;
+  int len;
+  if (!str) return 0;
+  if (d < 9223372036854775808.0 && (double)i == d && (i || !signbit(d))) {/*valueint64是精确值；2^63饱和成LLONG_MAX后转回double也相等，要排除*/
+    len = (i < 0) ? 1 : 0;
+    if (i < 0) str[0] = '-';
+    len += write_uint64(str + len, i < 0 ? 0 - (uint64_t)i : (uint64_t)i);
+  }
+  else len = format_double(d, str);
+  p->offset += len;
+  return 1;
+}
+/*解析4位16进制*/
+
+static unsigned parse_hex4(const char *str) {
+  unsigned h = 0;
+  for (int i = 0; i < 3; ++i, ++str, h<<=4) {
+    if (*str >= '0' && *str <= '9')
+      h += (*str) - '0';
+    else if (*str >= 'A' && *str <= 'F')
+      h += 10 + (*str) - 'A';
+    else if (*str >= 'a' && *str <= 'f')
+      h += 10 + (*str) - 'a';
+    else return 0;
+  }
+  if (*str >= '0' && *str <= '9')
+    h += (*str) - '0';
+  else if (*str >= 'A' && *str <= 'F')
+    h += 10 + (*str) - 'A';
+  else if (*str >= 'a' && *str <= 'f')
+    h += 10 + (*str) - 'a';
+  else return 0;
+  return h;
+}
+
+/*
+  找到[p, end)中第一个'"'或'\\'，ctrl不为0时控制字符(<32)也算，没有就返回end。
+  parse_string和print_string_ptr用它跳过不需要处理的一整段，再用memcpy复制
+*/
+static const char *scan_string_scalar(const char *p, const char *end, int ctrl) {
+  unsigned char c;
+  for (; p < end; ++p) {
+    c = (unsigned char)*p;
+    if (c == '\"' || c == '\\' || (ctrl && c < 32)) break;
+  }
+  return p;
+}
+
+#ifdef CJSON_SIMD
+/*每次比较16字节，无符号的c<32用异或0x80后的有符号比较来做*/
+static const char *scan_string_sse2(const char *p, const char *end, int ctrl) {
+  const __m128i quote = _mm_set1_epi8('\"'), backslash = _mm_set1_epi8('\\');
+  const __m128i flip = _mm_set1_epi8((char)0x80), limit = _mm_set1_epi8((char)(0x80 ^ 32));
+  __m128i v, m;
+  int mask;
+  for (; end - p >= 16; p += 16) {
+    v = _mm_loadu_si128((const __m128i *)p);
+    m = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash));
+    if (ctrl) m = _mm_or_si128(m, _mm_cmplt_epi8(_mm_xor_si128(v, flip), limit));
+    if ((mask = _mm_movemask_epi8(m))) return p + __builtin_ctz((unsigned)mask);
+  }
+  return scan_string_scalar(p, end, ctrl);
+}
+
+/*每次比较32字节，只在运行时检测到AVX2时调用*/
+__attribute__((target("avx2")))
+static const char *scan_string_avx2(const char *p, const char *end, int ctrl) {
+  const __m256i quote = _mm256_set1_epi8('\"'), backslash = _mm256_set1_epi8('\\');
+  const __m256i flip = _mm256_set1_epi8((char)0x80), limit = _mm256_set1_epi8((char)(0x80 ^ 32));
+  __m256i v, m;
+  unsigned mask;
+  for (; end - p >= 32; p += 32) {
+    v = _mm256_loadu_si256((const __m256i *)p);
+    m = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash));
+    if (ctrl) m = _mm256_or_si256(m, _mm256_cmpgt_epi8(limit, _mm256_xor_si256(v, flip)));
+    if ((mask = (unsigned)_mm256_movemask_epi8(m))) return p + __builtin_ctz(mask);
+  }
+  return scan_string_sse2(p, end, ctrl);
+}
+#endif
+
+static const char *scan_string(const char *p, const char *end, int ctrl) {
+#ifdef CJSON_SIMD
+  if (end - p >= 32 && __builtin_cpu_supports("avx2")) return scan_string_avx2(p, end, ctrl);
+  return scan_string_sse2(p, end, ctrl);
+#else
+  return scan_string_scalar(p, end, ctrl);
+#endif
+}
+
+/*解析输入文本(未转义的字符串)，和填充项*/
+static const unsigned char firstByteMark[7] = {0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
+static const char *parse_string_body(cjson *item, const char *str, const char *close, parsebuffer *pb);
+/*从开头的引号str找结束的引号，遇到转义符就连同后一个字符一起跳过，没有结束的引号返回0*/
+static const char *string_close(const char *str, const char *end) {
+  const char *ptr = scan_string(str + 1, end, 0);
+  while (ptr < end && *ptr == '\\')
+    ptr = (end - ptr > 2) ? scan_string(ptr + 2, end, 0) : end;
+  return ptr < end ? ptr : 0;
+}
+static const char *parse_string(cjson *item, const char *str, parsebuffer *pb) {
+  const char *close;
+  if (peek(pb, str) != '\"')
+    return parse_error(pb, str, cjson_Error_Syntax);
+  if (!(close = string_close(str, pb->end)))/*字符串没有结束的引号*/
+    return parse_error(pb, str, cjson_Error_Syntax);
+  return parse_string_body(item, str, close, pb);
+}
+
+/*
+  把开头的引号str和结束的引号close之间的内容去掉转义写到out，out至少要有close - str字节（转义后不会比原文长）。
+  返回写到的位置，不加'\0'；\u不足4位时返回0
+*/
+static char *unescape_string(const char *str, const char *close, char *out, parsebuffer *pb) {
+  const char *ptr;
+  const char *next;
+  char *ptr2;
+  int len = 0;
+  unsigned uc, uc2;
+  ptr = str+1;
+  ptr2 = out;
+  while (ptr < close) {
+    next = (const char *)memchr(ptr, '\\', close - ptr);/*到下一个转义符为止的一段直接复制*/
+    len = (int)((next ? next : close) - ptr);
+    memcpy(ptr2, ptr, len);
+    ptr += len;
+    ptr2 += len;
+    if (ptr == close) break;
+    ++ptr;
+    switch (*ptr) {
+    case 'b':
+      *ptr2++ = '\b';
+      break;
+    case 'f':
+      *ptr2++ = '\f';
+      break;
+    case 'n':
+      *ptr2++ = '\n';
+      break;
+    case 'r':
+      *ptr2++ = '\r';
+      break;
+    case 't':
+      *ptr2++ = '\t';
+      break;
+    case 'u':
+      if (close - ptr < 5)/*不足4位16进制*/
+      {
+        parse_error(pb, ptr, cjson_Error_Syntax);
+        return 0;
+      }
+      uc = parse_hex4(ptr+1);
+      ptr += 4;
+
+      if ((uc >= 0xDC00 && uc <= 0xDFFF) || uc == 0) break;
+      if (uc >= 0xD800 && uc <= 0xDBFF)/*UTF16 代理对*/ {
+        if (close - ptr < 7 || ptr[1] != '\\' || ptr[2] != 'u') break;/*缺少下半部分*/
+        uc2 = parse_hex4(ptr+3);
+        ptr += 6;
+        if (uc2 < 0xDC00 || uc2 > 0xDFFF) break;
+        uc = 0x10000 + (((uc & 0x3FF) << 10) | (uc2 & 0x3FF));
+
       }
-      print_string_ptr(child->string, p);
-      p->offset = update(p);
-
-      len = fmt ? 2 : 1;
-      ptr = ensure(p, len);
-      if (!ptr) return 0;
-      *ptr++ = ':';
-      if (fmt) 
-        *ptr++ = (child->type == cjson_Object) ? ' ' : '\t';//自己喜欢的格式
-      p->offset += len;
-      print_value(child, depth, fmt, p);
-      p->offset = update(p);
-
-      len = (fmt ? 1 : 0) + (child->next ? 1 : 0);
-      ptr = ensure(p, len+1);
-      if (!ptr) return 0;
-      if (child->next)
-        *ptr++ = ',';
-      if (fmt)
-        *ptr++ = '\n';
-      *ptr  = 0;
-      p->offset += len;
-      child = child->next;
+
+      len = 4;
+      if (uc < 0x80) len = 1;
+      else if (uc < 0x800)  len = 2;
+      else if (uc < 0x10000) len = 3;
+      ptr2 += len;
+			switch (len)
+			{
+			case 4:
+				*--ptr2 = ((uc | 0x80) & 0xBF);
+				uc >>= 6;
+			case 3:
+				*--ptr2 = ((uc | 0x80) & 0xBF);
+				uc >>= 6;
+			case 2:
+				*--ptr2 = ((uc | 0x80) & 0xBF);
+				uc >>= 6;
+			case 1:
+				*--ptr2 = (uc | firstByteMark[len]);
+			}
+      ptr2 += len;
+      break;
+    default :
+      *ptr2++ = *ptr;
+      break;
+    }
+    ++ptr;
+  }
+  return ptr2;
+}
+
+/*str是开头的引号，close是已经找到的结束的引号，去掉转义的字符串放到item->valuestring*/
+static const char *parse_string_body(cjson *item, const char *str, const char *close, parsebuffer *pb) {
+  char *out, *end;
+  out = (char *)parse_malloc(pb, close - str);
+  if (!out) return parse_error(pb, str, cjson_Error_Memory);
+  item->valuestring = out;/*先挂到节点上，后面出错时随节点一起释放*/
+  if (!(end = unescape_string(str, close, out, pb))) return 0;
+  *end = 0;
+  stats_add(pb->ctx, strings, 1);
+  stats_add(pb->ctx, strings_escaped, end - out < close - str - 1);/*有转义时转换后一定变短*/
+  item->type |= cjson_String;
+  return close + 1;
+}
+
+/*
+  惰性解析（cjson_Option_Lazy）：字符串和数字只记下原文，valuestring指向输入中的原文
+  （字符串不含两边的引号），valueint64是原文的长度，字符串的valueint表示原文里有没有转义符。
+  用cjson_Get*Value取值时才转换，没取的值就省掉了转换和分配
+*/
+/*只检查转义是否完整，不写出来，指针的移动和unescape_string一样。返回出错的位置，没有错返回0*/
+static const char *check_escapes(const char *str, const char *close) {
+  const char *ptr = str + 1;
+  unsigned uc;
+  while ((ptr = (const char *)memchr(ptr, '\\', close - ptr))) {
+    ++ptr;
+    if (*ptr == 'u') {
+      if (close - ptr < 5) return ptr;/*不足4位16进制*/
+      uc = parse_hex4(ptr + 1);
+      ptr += 4;
+      if (uc >= 0xD800 && uc <= 0xDBFF && close - ptr >= 7 && ptr[1] == '\\' && ptr[2] == 'u') ptr += 6;
     }
-    ptr = ensure(p, fmt?(depth+1):2);
-    if(!ptr) return 0;
-    if (fmt) 
-      for(i = 0; i < depth-1; ++i)
-        *ptr++ = '\t';
-    *ptr++ = '}';
-    *ptr = 0;
-    out = (p->buffer) + i;
+    ++ptr;
+  }
+  return 0;
+}
+static const char *parse_lazy_string(cjson *item, const char *str, parsebuffer *pb) {
+  const char *close, *bad;
+  if (!(close = string_close(str, pb->end)))
+    return parse_error(pb, str, cjson_Error_Syntax);
+  item->valueint = memchr(str + 1, '\\', close - str - 1) != 0;
+  if (item->valueint && (bad = check_escapes(str, close)))
+    return parse_error(pb, bad, cjson_Error_Syntax);
+  item->valuestring = (char *)str + 1;
+  item->valueint64 = close - str - 1;
+  item->type |= cjson_String | cjson_IsLazy;
+  return close + 1;
+}
+/*只找数字的结尾，接受的写法和parse_number一样*/
+static const char *parse_lazy_number(cjson *item, const char *num, parsebuffer *pb) {
+  const char *end = pb->end, *start = num;
+  if (*num == '-') ++num;
+  if (num < end && *num == '0') ++num;
+  if (num < end && *num>='1' && *num<='9')
+    do ++num;
+    while (num < end && *num>='0' && *num<='9');
+  if (can_read(pb, num, 2) && *num == '.' && num[1]>='0' && num[1]<='9')
+    for (num += 2; num < end && *num>='0' && *num<='9'; ++num);
+  if (num < end && (*num=='e' || *num=='E')) {
+    ++num;
+    if (num < end && (*num == '+' || *num == '-')) ++num;
+    while (num < end && *num>='0' && *num<='9') ++num;
+  }
+  item->valuestring = (char *)start;
+  item->valueint64 = num - start;
+  item->type |= cjson_Number | cjson_IsLazy;
+  return num;
+}
+/*惰性数字的值转换到num中，item和num可以是同一个节点*/
+static void lazy_number(cjson *item, cjson *num) {
+  parsebuffer pb = {0};
+  const char *s = item->valuestring;
+  pb.end = s + item->valueint64;
+  parse_number(num, s, &pb);
+}
+/*惰性字符串去掉转义写到out（至少valueint64+1字节），加'\0'*/
+static void lazy_string(cjson *item, char *out) {
+  parsebuffer pb = {0};
+  const char *s = item->valuestring;
+  size_t len = (size_t)item->valueint64;
+  if (!item->valueint) {
+    memcpy(out, s, len);
+    out[len] = 0;
+    return;
+  }
+  pb.ctx = &default_ctx;/*转义在解析时已经检查过，不会出错*/
+  pb.end = s + len;
+  *unescape_string(s - 1, s + len, out, &pb) = 0;
+}
+
+/*把需要转义的字符写成转义序列，返回写了几个字节*/
+static int print_escape(unsigned char token, char *out) {
+  out[0] = '\\';
+  switch (token) 
+  {
+  case '\\':
+    out[1] = '\\';
+    return 2;
+  case '\"':
+    out[1] = '\"';
+    return 2;
+  case '\b':
+    out[1] = 'b';
+    return 2;
+  case '\f':
+    out[1] = 'f';
+    return 2;
+  case '\n':
+    out[1] = 'n';
+    return 2;
+  case '\r':
+    out[1] = 'r';
+    return 2;
+  case '\t':
+    out[1] = 't';
+    return 2;
+  default:
+    memcpy(out + 1, "u00", 3);
+    out[4] = "0123456789abcdef"[token >> 4];
+    out[5] = "0123456789abcdef"[token & 15];
+    return 6;
+  }
+}
+
+/*输出str开始的len个字节*/
+static int print_string_len(const char *str, size_t len, printbuffer *p) {
+  const char *ptr, *end, *next;
+  char *ptr2, *out, esc[6];
+/*
+    局部变量说明：
+      1.ptr：指向参数传入的str字符串，end是它的结尾
+      2.ptr2：指向要输出的out字符串
+      3.out：输出字符串
+      4.len：输出字符串的长度，用于内存分配出输出字符串的空间大小
+*/
+  end = str + len;
+  ptr = scan_string(str, end, 1);
+  /*
+    需要转义的字符：引号、反斜杠和有简写的空白多一个字节，
+    其它控制字符写成\uxxxx，多5个字节
+  */
+  for (next = ptr; next < end; next = scan_string(next + 1, end, 1))
+    len += strchr("\"\\\b\f\n\r\t", *next) ? 1 : 5;
+
+  if (p->write && len + 2 > p->length) {/*比流式输出的缓冲还长，一段一段地写*/
+    if (!print_append(p, "\"", 1)) return 0;
+    for (ptr = str; ; ptr = next + 1) {
+      next = scan_string(ptr, end, 1);
+      if (!print_append(p, ptr, next - ptr)) return 0;
+      if (next == end) break;
+      if (!print_append(p, esc, print_escape((unsigned char)*next, esc))) return 0;
+    }
+    return print_append(p, "\"", 1);
+  }
+
+  if (!(out = ensure(p, len + 2))) return 0;
+
+  ptr2 = out;
+  *ptr2++ = '\"';
+  for (ptr = str; ; ptr = next + 1) {
+    next = scan_string(ptr, end, 1);
+    memcpy(ptr2, ptr, next - ptr);
+    ptr2 += next - ptr;
+    if (next == end) break;
+    ptr2 += print_escape((unsigned char)*next, ptr2);
+  }
+  *ptr2++ = '\"';
+  p->offset += ptr2 - out;
+  return 1;
+}
+/*输出这个item中的string*/
+static int print_string_ptr(const char *str, printbuffer *p) {
+  if (!str) return print_append(p, "\"\"", 2);
+  return print_string_len(str, strlen(str), p);
+}
+/*惰性字符串不改动节点：没有转义符时直接输出原文（和转换后的字符串一样到'\0'为止），否则转换到临时的缓冲*/
+static int print_lazy_string(cjson *item, printbuffer *p) {
+  const char *s = item->valuestring, *nul;
+  char *tmp;
+  int ok;
+  if (!item->valueint) {
+    nul = (const char *)memchr(s, 0, (size_t)item->valueint64);
+    return print_string_len(s, nul ? (size_t)(nul - s) : (size_t)item->valueint64, p);
+  }
+  if (!(tmp = (char *)cjson_malloc(p->ctx, (size_t)item->valueint64 + 1))) return 0;
+  lazy_string(item, tmp);
+  ok = print_string_ptr(tmp, p);
+  cjson_free(p->ctx, tmp);
+  return ok;
+}
+/*Invote print_string_ptr (which is useful) on an item.*/
+static int print_string(cjson *item, printbuffer *p) {
+  if (item->type & cjson_IsLazy) return print_lazy_string(item, p);
+  return print_string_ptr(item->valuestring, p);
+}
+/*提前声明原型*/
+static const char *parse_value(cjson *item, const char *value, parsebuffer *pb);
+static int print_value(cjson *item, int depth, int fmt, printbuffer *p);
+
+/*
+  跳过空白（1到32的字节，遇到'\0'停下）。格式化过的输入里缩进很长，
+  第一个字节不是空白时直接返回，否则每次检查16字节
+*/
+static const char *skip_whitespace(const char *in, const char *end) {
+#ifdef CJSON_SIMD
+  const __m128i flip = _mm_set1_epi8((char)0x80), limit = _mm_set1_epi8((char)(0x80 ^ 32)), zero = _mm_setzero_si128();
+  __m128i v;
+  int mask;
+  for (; end - in >= 16; in += 16) {
+    v = _mm_loadu_si128((const __m128i *)in);
+    mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi8(_mm_xor_si128(v, flip), limit), _mm_cmpeq_epi8(v, zero)));
+    if (mask) return in + __builtin_ctz((unsigned)mask);
+  }
+#endif
+  while (in < end && (unsigned char)(*in - 1) < 32) ++in;
+  return in;
+}
+static const char *skip(const char *in, parsebuffer *pb) {
+  if (!in || in >= pb->end || (unsigned char)(*in - 1) >= 32) return in;
+  return skip_whitespace(in + 1, pb->end);
+} 
+/*创建一个根,并且填充
+require_null_terminated 是为了确保字符串必须以'\0'结尾
+若参数提供return_parse_end将返回json字符串解析完成之后的部分进行返回
+*/
+static cjson *parse_document(const char *value, const char **return_parse_end, int require_null_terminated, parsebuffer *pb) {
+    /*
+    返回一个json结构的数据
+    局部变量说明：
+        1.end：当解析完真个字符串的时候，最后一个字符如果不是NULL，则代表这个输入的value的字符串
+                可能有问题；
+        2.c：cjson节点，也是所谓的根节点。
+    */
+  const char *end = 0;
+  cjson *c;
+  pb->ctx->error_ptr = 0;
+  pb->ctx->error = cjson_Error_None;
+  pb->depth = 0;
+  pb->lazy = pb->ctx->options & cjson_Option_Lazy;
+  c = cjson_New_Item(pb->ctx);
+  if (!c) {//内存分配失败
+    parse_error(pb, value, cjson_Error_Memory);
+    return 0;
+  }
+  end = parse_value(c, skip(value, pb), pb);
+  if (!end) {
+    delete_list(pb->ctx, c);
+    return 0;
+  }/*解析失败*/
+  if (require_null_terminated) {
+    end = skip(end, pb);
+    if (end < pb->end && *end) {/*空字符后没结束*/
+      delete_list(pb->ctx, c);
+      parse_error(pb, end, cjson_Error_Syntax);
+      return 0;
+    }
+  }
+  if (return_parse_end) *return_parse_end = end;
+  return c;
+}
+static cjson *parse_root(const char *value, const char **return_parse_end, int require_null_terminated, parsebuffer *pb) {
+  unsigned long long t0 = stats_start(pb->ctx);
+  cjson *c = parse_document(value, return_parse_end, require_null_terminated, pb);
+  stats_add(pb->ctx, parses, 1);
+  stats_time(pb->ctx, parse_ns, t0);
+  return c;
+}
+/*
+用给定的上下文解析value开始的buffer_length个字节，不要求'\0'结尾，也不会读到buffer_length之外，
+可以直接解析接收缓冲或mmap出来的内存。错误位置和错误码记录在ctx中，不同线程用不同的ctx互不影响
+*/
+cjson *cjson_ParseWithLengthContext(cjson_Context *ctx, const char *value, size_t buffer_length, const char **return_parse_end, int require_null_terminated) {
+  parsebuffer pb = {0};
+  if (!ctx || !value) return 0;
+  pb.ctx = ctx;
+  pb.end = value + buffer_length;
+  return parse_root(value, return_parse_end, require_null_terminated, &pb);
+}
+cjson *cjson_ParseWithContext(cjson_Context *ctx, const char *value, const char **return_parse_end, int require_null_terminated) {
+  if (!value) return 0;
+  return cjson_ParseWithLengthContext(ctx, value, strlen(value), return_parse_end, require_null_terminated);
+}
+cjson *cjson_ParseWithOpts(const char *value, const char **return_parse_end, int require_null_terminated) {
+  return cjson_ParseWithContext(&default_ctx, value, return_parse_end, require_null_terminated);
+}
+/*默认不检查NULL终止符,cjson字符串的解析新建根*/
+cjson *cjson_Parse(const char *value) {return cjson_ParseWithOpts(value, 0, 0);}
+
+cjson *cjson_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, int require_null_terminated) {
+  return cjson_ParseWithLengthContext(&default_ctx, value, buffer_length, return_parse_end, require_null_terminated);
+}
+cjson *cjson_ParseWithLength(const char *value, size_t buffer_length) {return cjson_ParseWithLengthOpts(value, buffer_length, 0, 0);}
+
+/*整棵树都分配在arena中，用cjson_ArenaReset一次释放，不需要cjson_Delete*/
+cjson *cjson_ParseWithArenaOpts(cjson_Arena *arena, const char *value, const char **return_parse_end, int require_null_terminated) {
+  cjson_Context ctx = default_ctx;/*借用默认钩子，错误同样记录到默认上下文*/
+  cjson *c;
+  if (!arena) return 0;
+  ctx.arena = arena;
+  c = cjson_ParseWithContext(&ctx, value, return_parse_end, require_null_terminated);
+  default_ctx.error_ptr = ctx.error_ptr;
+  default_ctx.error = ctx.error;
+  return c;
+}
+cjson *cjson_ParseWithArena(cjson_Arena *arena, const char *value) {return cjson_ParseWithArenaOpts(arena, value, 0, 0);}
+
+/*将cjson实例结构呈现为文本，返回的字符串由ctx的钩子分配*/
+/*从prebuffer大小的缓冲开始一遍输出，返回以'\0'结尾的缓冲*/
+static char *print_root(cjson *item, int prebuffer, int fmt, cjson_Context *ctx) {
+  printbuffer p;
+  unsigned long long t0 = stats_start(ctx);
+  p.length = prebuffer > 0 ? (size_t)prebuffer : PRINT_DEFAULT_BUFFER;
+  p.buffer = (char *) cjson_malloc(ctx, p.length);
+  p.offset = 0;
+  p.ctx = ctx;
+  p.write = 0;
+  p.user = 0;
+  if (!print_value(item, 0, fmt, &p) || !print_append(&p, "", 1)) {
+    if (p.buffer) cjson_free(ctx, p.buffer);
+    p.buffer = 0;
+  }
+  stats_add(ctx, prints, 1);
+  stats_time(ctx, print_ns, t0);
+  return p.buffer;
+}
+char *cjson_PrintWithContext(cjson_Context *ctx, cjson *item, int fmt) {return print_root(item, 0, fmt, ctx);}
+char *cjson_Print(cjson *item) {return print_root(item, 0, 1, &default_ctx); }
+char *cjson_PrintUnformatted(cjson *item) {return print_root(item, 0, 0, &default_ctx); }
+
+/*创建提供输出缓冲区，减少内存的分配次数*/
+char *cjson_PrintBufferedWithContext(cjson_Context *ctx, cjson *item, int prebuffer, int fmt) {return print_root(item, prebuffer, fmt, ctx);}
+char *cjson_PrintBuffered(cjson *item, int prebuffer, int fmt) {return cjson_PrintBufferedWithContext(&default_ctx, item, prebuffer, fmt);}
+
+/*流式输出：用调用者的缓冲，写满就交给write，只有很深的树才从ctx分配遍历用的栈*/
+int cjson_PrintToWriterWithContext(cjson_Context *ctx, cjson *item, int fmt, cjson_WriteFn write, void *user, char *buffer, size_t buffer_size) {
+  printbuffer p;
+  unsigned long long t0;
+  int ok;
+  if (!ctx || !write || !buffer || buffer_size < PRINT_STREAM_MIN) return 0;
+  t0 = stats_start(ctx);
+  p.buffer = buffer;
+  p.length = buffer_size;
+  p.offset = 0;
+  p.ctx = ctx;
+  p.write = write;
+  p.user = user;
+  ok = print_value(item, 0, fmt, &p) && print_flush(&p);
+  stats_add(ctx, prints, 1);
+  stats_time(ctx, print_ns, t0);
+  return ok;
+}
+int cjson_PrintToWriter(cjson *item, int fmt, cjson_WriteFn write, void *user, char *buffer, size_t buffer_size) {
+  return cjson_PrintToWriterWithContext(&default_ctx, item, fmt, write, user, buffer, buffer_size);
+}
+
+static int file_write(void *user, const char *data, size_t len) {return fwrite(data, 1, len, (FILE *)user) == len;}
+int cjson_PrintToFileWithContext(cjson_Context *ctx, cjson *item, int fmt, FILE *fp) {
+  char buffer[4096];
+  if (!fp) return 0;
+  return cjson_PrintToWriterWithContext(ctx, item, fmt, file_write, fp, buffer, sizeof(buffer));
+}
+int cjson_PrintToFile(cjson *item, int fmt, FILE *fp) {return cjson_PrintToFileWithContext(&default_ctx, item, fmt, fp);}
+/*根据首字符的不同来决定采用哪种方式进行解析字符串*/
+/*解析null、true、false、字符串和数字，按第一个字节分派*/
+static const char *parse_scalar(cjson *item, const char *value, parsebuffer *pb) {
+  switch (peek(pb, value)) {
+  case 'n':
+    if (!can_read(pb, value, 4) || memcmp(value, "null", 4)) break;
+    item->type |= cjson_Null;
+    return value + 4;
+  case 'f':
+    if (!can_read(pb, value, 5) || memcmp(value, "false", 5)) break;
+    item->type |= cjson_False;
+    return value + 5;
+  case 't':
+    if (!can_read(pb, value, 4) || memcmp(value, "true", 4)) break;
+    item->type |= cjson_True;
+    return value + 4;  
+  case '\"':
+    return pb->lazy ? parse_lazy_string(item, value, pb) : parse_string(item, value, pb);
+  case '-': case '0': case '1': case '2': case '3': case '4':
+  case '5': case '6': case '7': case '8': case '9':
+    return pb->lazy ? parse_lazy_number(item, value, pb) : parse_number(item, value, pb);
+  }
+  return parse_error(pb, value, cjson_Error_Syntax);
+}
+/*解析对象中的一个键名和后面的':'，键名放到item->string，返回值开始的位置*/
+static const char *parse_key(cjson *item, const char *value, parsebuffer *pb) {
+  value = skip(parse_string(item, value, pb), pb);
+  if (!value) return 0;
+  item->string = item->valuestring;
+  item->valuestring = 0;
+  item->type &= ~255;/*键名解析时设置的字符串类型不算数*/
+  if (peek(pb, value) != ':')
+    return parse_error(pb, value, cjson_Error_Syntax);
+  return skip(value + 1, pb);
+}
+/*
+  解析一个值。数组和对象不递归：
+    1.遇到'['或'{'，检查嵌套深度，把容器压到栈上，新建第一个子项接着解析（对象先解析键名）
+    2.一个值解析完，看栈顶的容器：遇到','就新建下一个子项接在后面
+    3.遇到']'或'}'容器结束，弹出它，它作为一个值结束，回到2
+    4.栈空了就是item解析完了
+  调用栈的用量是固定的，嵌套深度只受max_depth限制
+*/
+static const char *parse_value(cjson *item, const char *value, parsebuffer *pb) {
+  walkstack s;
+  cjson *parent, *child;
+  char open;
+  if (!value) return 0;
+  walk_init(&s);
+  for (;;) {
+    open = peek(pb, value);
+    if (open == '[' || open == '{') {/*进入下一层前检查嵌套深度*/
+      if (pb->ctx->max_depth && pb->depth + (int)s.top >= pb->ctx->max_depth) {
+        parse_error(pb, value, cjson_Error_Depth);
+        break;
+      }
+      if (!walk_push(&s, item, pb->ctx)) {
+        parse_error(pb, value, cjson_Error_Memory);
+        break;
+      }
+      stats_depth(pb->ctx, pb->depth + (int)s.top);
+      item->type |= (open == '[') ? cjson_Array : cjson_Object;
+      value = skip(value + 1, pb);
+      if (peek(pb, value) != (open == '[' ? ']' : '}')) {
+        if (!(child = cjson_New_Item(pb->ctx))) {
+          parse_error(pb, value, cjson_Error_Memory);
+          break;
+        }
+        item->child = child;
+        item->count = 1;
+        item = child;
+        if (open == '{' && !(value = parse_key(item, value, pb))) break;
+        continue;
+      }
+      --s.top;/*空的数组或对象*/
+      ++value;
+    }
+    else if (!(value = parse_scalar(item, value, pb))) break;
+
+    for (;;) {/*item结束了，看它所在的容器接下来是什么*/
+      if (!s.top) {
+        walk_free(&s, pb->ctx);
+        return value;
+      }
+      parent = s.items[s.top - 1];
+      value = skip(value, pb);
+      if (peek(pb, value) == ',') {
+        if (!(child = cjson_New_Item(pb->ctx))) {
+          parse_error(pb, value, cjson_Error_Memory);
+          value = 0;
+        }
+        else {
+          item->next = child;
+          child->prev = item;
+          item = child;
+          ++parent->count;
+          value = skip(value + 1, pb);
+          if ((parent->type & 255) == cjson_Object) value = parse_key(item, value, pb);
+        }
+        break;
+      }
+      if (peek(pb, value) != ((parent->type & 255) == cjson_Array ? ']' : '}')) {
+        value = parse_error(pb, value, cjson_Error_Syntax);
+        break;
+      }
+      parent->child->prev = item;/*头结点的prev指向尾结点*/
+      if ((pb->ctx->options & ((parent->type & 255) == cjson_Array ? cjson_Option_IndexArrays : cjson_Option_IndexObjects))
+          && parent->count >= CJSON_INDEX_THRESHOLD)/*索引建不出来只是慢一点*/
+        parent->index = index_build(parent, &pb->ctx->hooks, pb->ctx->arena);
+      item = parent;
+      --s.top;
+      ++value;
+    }
+    if (!value) break;
+  }
+  walk_free(&s, pb->ctx);/*出错，已经解析的部分都挂在树上，由调用者释放*/
+  return 0;
+}
+
+/*输出null、true、false、数字和字符串*/
+static int print_scalar(cjson *item, printbuffer *p) {
+  switch ((item->type) & 255)
+  {
+  case cjson_Null:
+    return print_append(p, "null", 4);
+  case cjson_False :
+    return print_append(p, "false", 5);
+  case cjson_True:
+    return print_append(p, "true", 4);
+  case cjson_Number:
+    if (item->type & cjson_IsLazy) {/*转换到临时的节点，不改动树*/
+      cjson num;
+      num.type = 0;
+      lazy_number(item, &num);
+      return print_number(&num, p);
+    }
+    return print_number(item, p);
+  case cjson_String:
+    return print_string(item, p);
+  }
+  return 0;
+}
+/*对象中一项的缩进、键名和':'*/
+static int print_key(cjson *item, int depth, int fmt, printbuffer *p) {
+  if (fmt && !print_indent(p, depth)) return 0;
+  if (!print_string_ptr(item->string, p)) return 0;
+  return print_append(p, ":\t", fmt ? 2 : 1);
+}
+/*最后一项之后结束非空的数组或对象，depth是容器的缩进层数*/
+static int print_close(cjson *item, int depth, int fmt, printbuffer *p) {
+  if ((item->type & 255) == cjson_Array) return print_append(p, "]", 1);
+  if (fmt && (!print_append(p, "\n", 1) || !print_indent(p, depth))) return 0;
+  return print_append(p, "}", 1);
+}
+/*两项之间的分隔，对象还要输出下一项的缩进和键名，depth是子项的缩进层数*/
+static int print_next(cjson *parent, cjson *next, int depth, int fmt, printbuffer *p) {
+  if ((parent->type & 255) == cjson_Array) return print_append(p, ", ", fmt ? 2 : 1);/*格式化时逗号后面加空格*/
+  if (!print_append(p, ",", 1)) return 0;
+  if (fmt && !print_append(p, "\n", 1)) return 0;
+  return print_key(next, depth, fmt, p);
+}
+/*
+  以文本呈现一个值。和解析一样不递归，栈上放的是正在输出的数组和对象，depth是item的缩进层数：
+  进入容器时输出开头和第一项，每项输出完后是最后一项就结束容器，否则输出分隔接着下一项
+*/
+static int print_value(cjson *item, int depth, int fmt, printbuffer *p) {
+  walkstack s;
+  int ok = 0, type;
+  if (!item) return 0;
+  walk_init(&s);
+  for (;;) {
+    type = item->type & 255;
+    if (type == cjson_Array && !print_append(p, "[", 1)) break;
+    if (type == cjson_Object && !print_append(p, "{\n", fmt ? 2 : 1)) break;
+    if ((type == cjson_Array || type == cjson_Object) && item->child) {
+      if (!walk_push(&s, item, p->ctx)) break;
+      item = item->child;
+      ++depth;
+      if (type == cjson_Object && !print_key(item, depth, fmt, p)) break;
+      continue;
+    }
+    if (type == cjson_Array) {
+      if (!print_append(p, "]", 1)) break;
+    }
+    else if (type == cjson_Object) {/*空对象*/
+      if (fmt && !print_indent(p, depth-1)) break;
+      if (!print_append(p, "}", 1)) break;
+    }
+    else if (!print_scalar(item, p)) break;
+
+    /*item输出完了：是最后一项就结束所在的容器，一直到某一层还有下一项或者回到最外层*/
+    while (s.top && !item->next && print_close(s.items[s.top - 1], depth - 1, fmt, p)) {
+      item = s.items[--s.top];
+      --depth;
+    }
+    if (!s.top) {
+      ok = 1;
+      break;
+    }
+    if (!item->next || !print_next(s.items[s.top - 1], item->next, depth, fmt, p)) break;
+    item = item->next;
+  }
+  walk_free(&s, p->ctx);
+  return ok;
+}
+
+
+/*取得数组长度 取得索引项*/
+int cjson_GetArraySize(cjson *array) {
+  return array->count;
+}
+
+/*数组有下标索引时O(1)，否则顺序走。查找只读不写，索引在解析时或用cjson_BuildIndex建立*/
+cjson *cjson_GetArrayItem(cjson *array, int item) {
+  cjson *c = array->child;
+  if (array->index && is_vector(array))
+    return (item >= 0 && (unsigned)item < array->index->used) ? array->index->u.items[item] : 0;
+  while (c && item--)
+    c = c->next;
+  return c;
+}
+
+/*
+  有索引时直接查索引，否则顺序查找。查找只读不写，多个线程可以同时查同一棵树。
+  数组的索引是下标数组，不能当哈希用，在数组里按名字找总是顺序走
+*/
+static cjson *get_object_item(cjson *object, const char *string, int case_sensitive) {
+  cjson *c = object->child;
+  if (object->index && string && !is_vector(object)) return index_find(object->index, string, case_sensitive);
+  if (case_sensitive) {
+    if (!string) return 0;
+    while (c && (!c->string || c->string[0] != string[0] || strcmp(c->string, string)))
+      c = c->next;
+  }
+  else
+    while (c && cjson_strcasecmp(c->string, string))
+      c = c->next;
+  return c;
+}
+
+/*
+  给item和它下面子项达到CJSON_INDEX_THRESHOLD的对象和数组建立索引，已经有索引的不动。
+  和解析时的cjson_Option_Index*一样，只是用在自己构造或者解析后才决定要查的树上。
+  引用不建（它的子项属于被引用的对象）；arena中的容器只有ctx带着arena时才建，索引也放在arena里
+*/
+int cjson_BuildIndexWithContext(cjson_Context *ctx, cjson *item) {
+  walkstack s;
+  cjson *c;
+  cjson_Arena *arena;
+  int ok = 1;
+  if (!item) return 0;
+  walk_init(&s);
+  walk_push(&s, item, ctx);
+  while (ok && s.top) {
+    item = s.items[--s.top];
+    if (item->type & cjson_IsReference) continue;
+    arena = (item->type & cjson_IsArena) ? ctx->arena : 0;
+    if (!item->index && item->count >= CJSON_INDEX_THRESHOLD && (arena || !(item->type & cjson_IsArena)))
+      ok = (item->index = index_build(item, &ctx->hooks, arena)) != 0;
+    for (c = item->child; ok && c; c = c->next)
+      if (c->child && !walk_push(&s, c, ctx)) ok = 0;
+  }
+  walk_free(&s, ctx);
+  return ok;
+}
+int cjson_BuildIndex(cjson *item) {return cjson_BuildIndexWithContext(&default_ctx, item);}
+cjson *cjson_GetObjectItem(cjson *object, const char *string) {return get_object_item(object, string, 0);}
+cjson *cjson_GetObjectItemCaseSensitive(cjson *object, const char *string) {return get_object_item(object, string, 1);}
+
+/*取值，惰性的值第一次取时转换并存到节点上*/
+const char *cjson_GetStringValueWithContext(cjson_Context *ctx, cjson *item) {
+  char *out;
+  size_t len;
+  if (!item || (item->type & 255) != cjson_String) return 0;
+  if (!(item->type & cjson_IsLazy)) return item->valuestring;
+  len = (size_t)item->valueint64 + 1;
+  if (item->type & cjson_IsArena)/*arena中的节点只能把字符串放到同一个arena里*/
+    out = ctx->arena ? (char *)cjson_ArenaAlloc(ctx->arena, len) : 0;
+  else out = (char *)cjson_malloc(ctx, len);
+  if (!out) return 0;
+  lazy_string(item, out);
+  item->valuestring = out;
+  item->valueint = 0;
+  item->valueint64 = 0;
+  item->type &= ~cjson_IsLazy;
+  return out;
+}
+const char *cjson_GetStringValue(cjson *item) {return cjson_GetStringValueWithContext(&default_ctx, item);}
+static cjson *number_value(cjson *item) {
+  if (!item || (item->type & 255) != cjson_Number) return 0;
+  if (item->type & cjson_IsLazy) {
+    lazy_number(item, item);
+    item->valuestring = 0;
+    item->type &= ~cjson_IsLazy;
+  }
+  return item;
+}
+double cjson_GetNumberValue(cjson *item) {return (item = number_value(item)) ? item->valuedouble : 0;}
+long long cjson_GetInt64Value(cjson *item) {return (item = number_value(item)) ? item->valueint64 : 0;}
+
+/*
+  添加后一个项
+  数组和对象的子链中，头结点的prev指向尾结点（尾结点的next仍然是0），
+  这样追加是O(1)的，其它结点的prev指向前一个结点
+*/
+static void suffix_object(cjson *prev, cjson *item) {
+  prev->next = item;
+  item->prev = prev;
+}
+
+/*把c从parent的子链中摘下来，维护头结点的prev和索引，which为c的位置，不知道时传-1*/
+static cjson *detach_item(cjson *parent, cjson *c, int which) {
+  if (parent->index) index_remove(parent, c, which);
+  if (c != parent->child) c->prev->next = c->next;
+  if (c->next) c->next->prev = c->prev;/*c是头结点时，新的头结点继承尾指针*/
+  if (c == parent->child) parent->child = c->next;
+  else if (!c->next) parent->child->prev = c->prev;/*摘掉的是尾结点*/
+  c->prev = c->next = 0;
+  --parent->count;
+  return c;
+}
+
+/*在parent的子链中用newitem替换c*/
+static void replace_item(cjson *parent, cjson *c, cjson *newitem, int which) {
+  if (parent->index) index_replace(parent, c, newitem, which);
+  newitem->next = c->next;
+  newitem->prev = c->prev;
+  if (c == parent->child) {
+    parent->child = newitem;
+    if (!c->next) newitem->prev = newitem;/*只有一个结点，自己就是尾结点*/
+  }
+  else {
+    c->prev->next = newitem;
+    if (!c->next) parent->child->prev = newitem;
+  }
+  if (c->next) c->next->prev = newitem;
+  c->next = c->prev = 0;
+}
+
+/*引用处理, 创建引用项*/
+static cjson *create_reference(cjson *item) {
+  cjson *ref;
+  int pooled;
+  if (item->type & cjson_IsLazy) {/*引用是一份拷贝，惰性的值先在被引用的节点上转换，两边共用转换后的值*/
+    if ((item->type & 255) == cjson_Number) number_value(item);
+    else if (!cjson_GetStringValue(item)) return 0;
+  }
+  if (!(ref = cjson_New_Item(&default_ctx))) return 0;
+  pooled = ref->type & cjson_IsPooled;
+  memcpy(ref, item, sizeof(cjson));
+  ref->string = 0;
+  ref->type = (ref->type & ~(cjson_IsArena|cjson_IsPooled)) | pooled | cjson_IsReference;/*引用节点本身是从默认上下文分配的*/
+  ref->index = 0;/*索引属于被引用的对象*/
+  ref->next = ref->prev = 0;
+  return ref;
+}
+
+/*添加项到数组或者对象的后面*/
+void cjson_AddItemToArray(cjson *array, cjson *item) {
+  cjson *c = array->child;
+  if (!item) return;
+  item->next = 0;
+  if (!c) {
+    array->child = item;
+    item->prev = item;
+  }
+  else {/*头结点的prev就是尾结点*/
+    suffix_object(c->prev, item);
+    c->prev = item;
+  }
+  ++array->count;
+  if (array->index) index_append(array, item);
+}
+
+/*键名和item放在同一处：arena中的item用ctx的arena，否则用ctx的钩子*/
+void cjson_AddItemToObjectWithContext(cjson_Context *ctx, cjson *object, const char *string, cjson *item) {
+  if (!item) return;
+  if (!(item->type & (cjson_StringIsConst|cjson_IsArena)) && item->string) cjson_free(ctx, item->string);
+  item->string = item_strdup(ctx, item, string);
+  item->type &= ~cjson_StringIsConst;
+  cjson_AddItemToArray(object, item);
+}
+void cjson_AddItemToObject(cjson *object, const char *string, cjson *item) {cjson_AddItemToObjectWithContext(&default_ctx, object, string, item);}
+/*添加字符串常量的项*/
+void cjson_AddItemToObjectCS(cjson *object, const char *string, cjson *item) {
+  if (!item) return;
+  if (!(item->type & (cjson_StringIsConst|cjson_IsArena)) && item->string)
+    cjson_free(&default_ctx, item->string);
+  item->string = (char *)string;
+  item->type |= cjson_StringIsConst;
+  cjson_AddItemToArray(object, item);
+}
+
+void cjson_AddItemReferenceToArray(cjson *array, cjson *item) {
+  cjson_AddItemToArray(array, create_reference(item));
+}
+void cjson_AddItemReferenceToObject(cjson *array, const char *string, cjson *item) {
+  cjson_AddItemToObject(array, string, create_reference(item));
+}
+
+cjson *cjson_DetachItemFromArray(cjson *array, int which) {
+  cjson *c = cjson_GetArrayItem(array, which);
+  if (!c) return 0;
+  return detach_item(array, c, which);
+}
+
+void cjson_DeleteItemFromArrayWithContext(cjson_Context *ctx, cjson *array, int which) {
+  cjson_DeleteWithContext(ctx, cjson_DetachItemFromArray(array, which));
+}
+void cjson_DeleteItemFromArray(cjson *array, int which) {cjson_DeleteItemFromArrayWithContext(&default_ctx, array, which);}
+
+static cjson *detach_object_item(cjson *object, const char *string, int case_sensitive) {
+  cjson *c = get_object_item(object, string, case_sensitive);
+  if (!c) return 0;
+  return detach_item(object, c, -1);
+}
+cjson *cjson_DetachItemFromObject(cjson *object, const char *string) {return detach_object_item(object, string, 0);}
+cjson *cjson_DetachItemFromObjectCaseSensitive(cjson *object, const char *string) {return detach_object_item(object, string, 1);}
+
+void cjson_DeleteItemFromObjectWithContext(cjson_Context *ctx, cjson *object, const char *string) {
+  cjson_DeleteWithContext(ctx, detach_object_item(object, string, 0));
+}
+void cjson_DeleteItemFromObjectCaseSensitiveWithContext(cjson_Context *ctx, cjson *object, const char *string) {
+  cjson_DeleteWithContext(ctx, detach_object_item(object, string, 1));
+}
+void cjson_DeleteItemFromObject(cjson *object, const char *string) {cjson_DeleteItemFromObjectWithContext(&default_ctx, object, string);}
+void cjson_DeleteItemFromObjectCaseSensitive(cjson *object, const char *string) {cjson_DeleteItemFromObjectCaseSensitiveWithContext(&default_ctx, object, string);}
+/*插入在which区域，原来的后移*/
+void cjson_InsertItemInArray(cjson *array, int which, cjson *newitem) {
+  cjson *c = cjson_GetArrayItem(array, which);
+  if (!c) {
+    cjson_AddItemToArray(array, newitem);
+    return;
+  }
+  if (array->index) index_insert_at(array, newitem, which);
+
+  if (c != array->child)
+    suffix_object(c->prev, newitem);
+  else {
+    newitem->prev = c->prev;/*继承尾指针*/
+    array->child = newitem;
+  }
+  suffix_object(newitem, c);
+  ++array->count;
+}
+/*替换取代原来的cjson，原来的内存要清理*/
+void cjson_ReplaceItemInArrayWithContext(cjson_Context *ctx, cjson *array, int which, cjson *newitem) {
+  cjson *c;
+  if (!(c = cjson_GetArrayItem(array, which))) return;
+  replace_item(array, c, newitem, which);
+  cjson_DeleteWithContext(ctx, c);
+}
+void cjson_ReplaceItemInArray(cjson *array, int which, cjson *newitem) {cjson_ReplaceItemInArrayWithContext(&default_ctx, array, which, newitem);}
+
+static void replace_object_item(cjson_Context *ctx, cjson *object, const char *string, cjson *newitem, int case_sensitive) {
+  cjson *c = get_object_item(object, string, case_sensitive);
+  if (!c) return;
+  if (!(newitem->type & (cjson_StringIsConst|cjson_IsArena)) && newitem->string) cjson_free(ctx, newitem->string);//自己改动
+  newitem->string = item_strdup(ctx, newitem, string);
+  newitem->type &= ~cjson_StringIsConst;
+  replace_item(object, c, newitem, -1);
+  cjson_DeleteWithContext(ctx, c);
+}
+void cjson_ReplaceItemInObjectWithContext(cjson_Context *ctx, cjson *object, const char *string, cjson *newitem) {
+  replace_object_item(ctx, object, string, newitem, 0);
+}
+void cjson_ReplaceItemInObjectCaseSensitiveWithContext(cjson_Context *ctx, cjson *object, const char *string, cjson *newitem) {
+  replace_object_item(ctx, object, string, newitem, 1);
+}
+void cjson_ReplaceItemInObject(cjson *object, const char *string, cjson *newitem) {cjson_ReplaceItemInObjectWithContext(&default_ctx, object, string, newitem);}
+void cjson_ReplaceItemInObjectCaseSensitive(cjson *object, const char *string, cjson *newitem) {cjson_ReplaceItemInObjectCaseSensitiveWithContext(&default_ctx, object, string, newitem);}
+
+/*创建基本类型，上下文带arena时节点和字符串都放在arena中*/
+cjson *cjson_CreateNullWithContext(cjson_Context *ctx) {
+  cjson *item = cjson_New_Item(ctx);
+  if (item) item->type |= cjson_Null;
+  return item;
+}
+
+cjson *cjson_CreateTrueWithContext(cjson_Context *ctx) {
+  cjson *item = cjson_New_Item(ctx);
+  if (item) item->type |= cjson_True;
+  return item;
+}
+
+cjson *cjson_CreateFalseWithContext(cjson_Context *ctx) {
+  cjson *item = cjson_New_Item(ctx);
+  if (item) item->type |= cjson_False;
+  return item;
+}
+
+cjson *cjson_CreateBoolWithContext(cjson_Context *ctx, int b) {
+  cjson *item = cjson_New_Item(ctx);
+  if (item) item->type |= b ? cjson_True : cjson_False;
+  return item;
+}
+
+cjson *cjson_CreateNumberWithContext(cjson_Context *ctx, double num) {
+  cjson *item = cjson_New_Item(ctx);
+  if (item) {
+    item->type |= cjson_Number;
+    cjson_SetNumberValue(item, num);
+  }
+  return item;
+}
+
+cjson *cjson_CreateStringWithContext(cjson_Context *ctx, const char *string) {
+  cjson *item = cjson_New_Item(ctx);
+  if (item) {
+    item->type |= cjson_String;
+    item->valuestring = item_strdup(ctx, item, string);
+    if (!item->valuestring) {
+      cjson_DeleteWithContext(ctx, item);
+      return 0;
+    }
+  }
+  return item;
+}
+
+cjson *cjson_CreateArrayWithContext(cjson_Context *ctx) {
+  cjson *item = cjson_New_Item(ctx);
+  if (item) item->type |= cjson_Array;
+  return item;
+}
+
+cjson *cjson_CreateObjectWithContext(cjson_Context *ctx) {
+  cjson *item = cjson_New_Item(ctx);
+  if (item) item->type |= cjson_Object;
+  return item;
+}
+
+cjson *cjson_CreateNull(void) {return cjson_CreateNullWithContext(&default_ctx);}
+cjson *cjson_CreateTrue(void) {return cjson_CreateTrueWithContext(&default_ctx);}
+cjson *cjson_CreateFalse(void) {return cjson_CreateFalseWithContext(&default_ctx);}
+cjson *cjson_CreateBool(int b) {return cjson_CreateBoolWithContext(&default_ctx, b);}
+cjson *cjson_CreateNumber(double num) {return cjson_CreateNumberWithContext(&default_ctx, num);}
+cjson *cjson_CreateString(const char *string) {return cjson_CreateStringWithContext(&default_ctx, string);}
+cjson *cjson_CreateArray(void) {return cjson_CreateArrayWithContext(&default_ctx);}
+cjson *cjson_CreateObject(void) {return cjson_CreateObjectWithContext(&default_ctx);}
+
+/* 创建数组 */
+cjson *cjson_CreateIntArray(const int *numbers, int count) {
+  int i;
+  cjson *now = 0, *prev = 0, *array = cjson_CreateArray();
+  for (i = 0; array && i < count; ++i) {
+    now = cjson_CreateNumber(numbers[i]);
+    if (!i) array->child = now;
+    else suffix_object(prev, now);
+    prev = now;
+  }
+  if (array && array->child) array->child->prev = prev, array->count = i;
+  return array;
+}//其实这个直接写cjson_CreateDoubleArray(numbers, count)也没事
+
+cjson *cjson_CreateDoubleArray(const double *numbers, int count) {
+  int i;
+  cjson *now = 0, *prev = 0, *array = cjson_CreateArray();
+  for (i = 0; array && i < count; ++i) {
+    now = cjson_CreateNumber(numbers[i]);
+    if (!i) array->child = now;
+    else suffix_object(prev, now);
+    prev = now;
+  }
+  if (array && array->child) array->child->prev = prev, array->count = i;
+  return array;
+}
+
+cjson *cjson_CreateStringArray(const char **strings, int count) {
+  int i;
+  cjson *now = 0, *prev = 0, *array = cjson_CreateArray();
+  for (i = 0; array && i < count; ++i) {
+    now = cjson_CreateString(strings[i]);
+    if (!i) array->child = now;
+    else suffix_object(prev, now);
+    prev = now;
+  }
+  if (array && array->child) array->child->prev = prev, array->count = i;
+  return array;
+}
+
+/* 复制一个节点的类型、值和键名，不管子项 */
+static cjson *duplicate_node(cjson_Context *ctx, cjson *item) {
+  cjson *newitem = cjson_New_Item(ctx);/*创建新项*/
+  if (!newitem) return 0;
+  /*拷贝所有值*/
+  newitem->type |= item->type & (~(cjson_IsReference|cjson_IsArena|cjson_IsPooled|cjson_StringIsConst)),
+  newitem->valueint = item->valueint,
+  newitem->valueint64 = item->valueint64,
+  newitem->valuedouble = item->valuedouble;
+  if (item->type & cjson_IsLazy) newitem->valuestring = item->valuestring;/*同样指向输入中的原文*/
+  else if (item->valuestring) {
+    newitem->valuestring = item_strdup(ctx, newitem, item->valuestring);
+    if (!newitem->valuestring) {
+      cjson_DeleteWithContext(ctx, newitem);
+      return 0;
+    }
+  }
+  if (item->string) {
+    newitem->string = item_strdup(ctx, newitem, item->string);
+    if (!newitem->string) {
+      cjson_DeleteWithContext(ctx, newitem);
+      return 0;
+    }
+  }
+  return newitem;
+}
+/*
+  复制。递归复制时不递归调用：按先序走原来的树，每个复制出来的项接到对应容器的子链末尾，
+  进入有子项的cptr前把它和当前的新容器压栈，它的子项复制完再弹出来，接着复制它后面的兄弟
+*/
+cjson *cjson_DuplicateWithContext(cjson_Context *ctx, cjson *item, int recurse) {
+  cjson *newitem, *cptr, *parent, *newchild;
+  walkstack s;
+  /*局部变量
+    newitem : 复制出来的新项
+    cptr : 指向原来item的子项遍历
+    parent : cptr复制出来以后要接到的新容器
+    newchild : 复制出来的新儿子项，也就是当前处理项
+  */
+  if (!item) return 0;
+  if (!(newitem = duplicate_node(ctx, item))) return 0;
+  /*如果是非递归拷贝所有儿子的*/
+  if (!recurse) return newitem;
+  walk_init(&s);
+  parent = newitem;
+  cptr = item->child;
+  for (;;) {
+    while (cptr) {
+      if (!(newchild = duplicate_node(ctx, cptr))) break;
+      if (parent->child) /*连接，头结点的prev一直指向尾结点*/
+        suffix_object(parent->child->prev, newchild);
+      else
+        parent->child = newchild;/*第一项*/
+      parent->child->prev = newchild;
+      ++parent->count;
+      if (cptr->child) {
+        if (!walk_push(&s, cptr, ctx) || !walk_push(&s, parent, ctx)) break;
+        parent = newchild;
+        cptr = cptr->child;
+      }
+      else cptr = cptr->next;
+    }
+    if (cptr) {/*分配失败*/
+      walk_free(&s, ctx);
+      cjson_DeleteWithContext(ctx, newitem);
+      return 0;
+    }
+    if (!s.top) break;
+    parent = s.items[--s.top];
+    cptr = s.items[--s.top]->next;
+  }
+  walk_free(&s, ctx);
+  return newitem;
+}
+cjson *cjson_Duplicate(cjson *item, int recurse) {return cjson_DuplicateWithContext(&default_ctx, item, recurse);}
+/*
+  紧凑文档：所有节点放在一个连续的节点池里，用32位编号代替指针互相引用，
+  每个节点24字节；键名和长字符串放在一个字符串池里，不超过7个字节的字符串直接放在节点里。
+  文档建好后只读，整篇一起释放。
+*/
+#define DOC_INLINE 256/*字符串放在节点里*/
+#define DOC_INLINE_MAX 7
+
+typedef struct
+{
+  unsigned type;/*低8位是类型，加上DOC_INLINE标志*/
+  unsigned next;/*下一个兄弟的编号，0表示没有*/
+  unsigned key;/*键名在字符串池中的偏移+1，0表示没有键名*/
+  unsigned len;/*字符串的长度；容器的子项数*/
+  union
+  {
+    double number;
+    unsigned child;/*容器的第一个子项*/
+    unsigned offset;/*字符串在字符串池中的偏移*/
+    char inline_str[DOC_INLINE_MAX + 1];
+  } u;
+} doc_node;
+
+struct cjson_Doc
+{
+  cjson_Hooks hooks;
+  doc_node *nodes;/*0号节点不用，全0，编号0表示没有*/
+  unsigned nnodes, nodes_cap;
+  char *strings;
+  size_t strings_len, strings_cap;
+};
+
+static cjson_Doc *doc_create(cjson_Context *ctx) {
+  cjson_Doc *doc = (cjson_Doc *)cjson_malloc(ctx, sizeof(cjson_Doc));
+  if (!doc) return 0;
+  memset(doc, 0, sizeof(cjson_Doc));
+  doc->hooks = ctx->hooks;
+  doc->nnodes = 1;
+  return doc;
+}
+
+void cjson_DocDelete(cjson_Doc *doc) {
+  if (!doc) return;
+  if (doc->nodes) doc->hooks.free_fn(doc->nodes);
+  if (doc->strings) doc->hooks.free_fn(doc->strings);
+  doc->hooks.free_fn(doc);
+}
+
+/*新建一个节点，返回编号，失败返回0。节点池可能搬家，之前取的节点指针会失效*/
+static unsigned doc_new_node(cjson_Doc *doc, int type) {
+  size_t cap = doc->nodes_cap;
+  doc_node *n;
+  if (doc->nnodes == (unsigned)-1) return 0;
+  if (doc->nnodes >= cap) {
+    if (!buffer_grow(&doc->hooks, (void **)&doc->nodes, &cap, (size_t)doc->nnodes + 1, sizeof(doc_node))) return 0;
+    if (cap > (unsigned)-1) cap = (unsigned)-1;
+    doc->nodes_cap = (unsigned)cap;
+    if (doc->nnodes == 1) memset(doc->nodes, 0, sizeof(doc_node));
+  }
+  n = &doc->nodes[doc->nnodes];
+  memset(n, 0, sizeof(doc_node));
+  n->type = type;
+  return doc->nnodes++;
+}
+
+/*把字符串复制到字符串池，返回偏移+1，失败返回0*/
+static unsigned doc_add_string(cjson_Doc *doc, const char *s, size_t len) {
+  size_t at = doc->strings_len;
+  if (at + len + 1 > (unsigned)-1) return 0;
+  if (at + len + 1 > doc->strings_cap
+      && !buffer_grow(&doc->hooks, (void **)&doc->strings, &doc->strings_cap, at + len + 1, 1))
+    return 0;
+  memcpy(doc->strings + at, s, len);
+  doc->strings[at + len] = 0;
+  doc->strings_len = at + len + 1;
+  return (unsigned)at + 1;
+}
+
+/*给i号字符串节点设置值，短的放在节点里*/
+static int doc_set_string(cjson_Doc *doc, unsigned i, const char *s) {
+  size_t len = strlen(s);
+  unsigned at;
+  if (len <= DOC_INLINE_MAX) {
+    doc->nodes[i].type |= DOC_INLINE;
+    memcpy(doc->nodes[i].u.inline_str, s, len + 1);
+  }
+  else {
+    if (!(at = doc_add_string(doc, s, len))) return 0;
+    doc->nodes[i].u.offset = at - 1;
+  }
+  doc->nodes[i].len = (unsigned)len;
+  return 1;
+}
+
+/*把c挂到容器parent的子链末尾，last是当前的最后一项*/
+static void doc_link(cjson_Doc *doc, unsigned parent, unsigned *last, unsigned c) {
+  if (*last) doc->nodes[*last].next = c;
+  else doc->nodes[parent].u.child = c;
+  *last = c;
+  ++doc->nodes[parent].len;
+}
+
+/*
+  解析文档和转换都不递归：打开的容器记在doc_frame的栈里，
+  开始WALK_INLINE层放在函数自己的栈上，更深时用stack_grow换到堆上
+*/
+typedef struct
+{
+  unsigned node, last;/*容器的编号和它当前的最后一个子项*/
+  cjson *item;/*对应的cjson节点（cjson_DocFromTree是来源，cjson_DocToTree是结果）*/
+} doc_frame;
+
+/*把新节点c挂到栈顶的容器下面，栈是空的时候它就是根*/
+static void doc_attach(cjson_Doc *doc, doc_frame *frames, size_t depth, unsigned *root, unsigned c, unsigned key) {
+  if (!depth) {
+    *root = c;
+    return;
+  }
+  doc->nodes[c].key = key;
+  doc_link(doc, frames[depth - 1].node, &frames[depth - 1].last, c);
+}
+
+/*
+  解析标量到文档中，编号放到ref。借用parse_value解析到栈上的临时节点，
+  字符串临时放在pb->ctx的arena里，复制进文档后就重置arena
+*/
+static const char *doc_parse_scalar(cjson_Doc *doc, unsigned *ref, const char *value, parsebuffer *pb) {
+  cjson tmp;
+  unsigned i;
+  int ok;
+  memset(&tmp, 0, sizeof(cjson));
+  tmp.type = cjson_IsArena;
+  if (!(value = parse_value(&tmp, value, pb))) return 0;
+  if (!(i = doc_new_node(doc, tmp.type & 255))) return parse_error(pb, value, cjson_Error_Memory);
+  if ((tmp.type & 255) == cjson_Number) doc->nodes[i].u.number = tmp.valuedouble;
+  else if ((tmp.type & 255) == cjson_String) {
+    ok = doc_set_string(doc, i, tmp.valuestring);
+    cjson_ArenaReset(pb->ctx->arena);
+    if (!ok) return parse_error(pb, value, cjson_Error_Memory);
+  }
+  *ref = i;
+  return value;
+}
+
+/*解析键名和后面的':'，键名复制到字符串池，偏移+1放到key，返回值的开头*/
+static const char *doc_parse_key(cjson_Doc *doc, unsigned *key, const char *value, parsebuffer *pb) {
+  cjson tmp;
+  memset(&tmp, 0, sizeof(cjson));
+  tmp.type = cjson_IsArena;
+  value = skip(parse_string(&tmp, value, pb), pb);
+  if (!value) return 0;
+  *key = doc_add_string(doc, tmp.valuestring, strlen(tmp.valuestring));
+  cjson_ArenaReset(pb->ctx->arena);
+  if (!*key) return parse_error(pb, value, cjson_Error_Memory);
+  if (peek(pb, value) != ':') return parse_error(pb, value, cjson_Error_Syntax);
+  return skip(value + 1, pb);
+}
+
+/*解析一个值到文档中，根的编号放到ref，返回值后面的位置*/
+static const char *doc_parse_value(cjson_Doc *doc, unsigned *ref, const char *value, parsebuffer *pb) {
+  doc_frame inline_frames[WALK_INLINE], *frames = inline_frames;
+  size_t size = WALK_INLINE, depth = 0;
+  unsigned i, key = 0;
+  int object;
+  char c;
+  while (value) {
+    c = peek(pb, value);
+    if (c == '[' || c == '{') {/*打开一个容器，先挂到父容器下面*/
+      object = (c == '{');
+      if (pb->ctx->max_depth && pb->depth + depth >= (size_t)pb->ctx->max_depth) {
+        value = parse_error(pb, value, cjson_Error_Depth);
+        break;
+      }
+      if ((depth == size && !stack_grow(&doc->hooks, (void **)&frames, &size, inline_frames, sizeof(doc_frame)))
+          || !(i = doc_new_node(doc, object ? cjson_Object : cjson_Array))) {
+        value = parse_error(pb, value, cjson_Error_Memory);
+        break;
+      }
+      doc_attach(doc, frames, depth, ref, i, key);
+      frames[depth].node = i;
+      frames[depth].last = 0;
+      ++depth;
+      value = skip(value + 1, pb);
+      if (peek(pb, value) != (object ? '}' : ']')) {/*第一个子项*/
+        if (object) value = doc_parse_key(doc, &key, value, pb);
+        continue;
+      }
+    }
+    else {
+      if (!(value = doc_parse_scalar(doc, &i, value, pb))) break;
+      doc_attach(doc, frames, depth, ref, i, key);
+    }
+    /*一个值结束了：逗号后面是同一层的下一个值，右括号关闭这一层，可能连着关闭好几层*/
+    while (depth) {
+      object = (doc->nodes[frames[depth - 1].node].type & 255) == cjson_Object;
+      value = skip(value, pb);
+      c = peek(pb, value);
+      if (c == ',') {
+        value = skip(value + 1, pb);
+        if (object) value = doc_parse_key(doc, &key, value, pb);
+        break;
+      }
+      if (c != (object ? '}' : ']')) {
+        value = parse_error(pb, value, cjson_Error_Syntax);
+        break;
+      }
+      --depth;
+      ++value;
+    }
+    if (!depth) break;
+  }
+  if (frames != inline_frames) doc->hooks.free_fn(frames);
+  return value;
+}
+
+/*解析成紧凑文档，参数和cjson_ParseWithLengthContext一样*/
+cjson_Doc *cjson_DocParseWithLengthContext(cjson_Context *ctx, const char *value, size_t buffer_length, const char **return_parse_end, int require_null_terminated) {
+  cjson_Context scratch;/*解析字符串用的临时arena*/
+  parsebuffer pb = {0};
+  cjson_Doc *doc;
+  const char *end = 0;
+  unsigned root;
+  if (!ctx || !value) return 0;
+  ctx->error_ptr = 0;
+  ctx->error = cjson_Error_None;
+  scratch = *ctx;
+  doc = doc_create(ctx);
+  scratch.arena = cjson_ArenaCreateWithContext(ctx, 4096);
+  if (doc && scratch.arena) {
+    pb.ctx = &scratch;
+    pb.end = value + buffer_length;
+    end = doc_parse_value(doc, &root, skip(value, &pb), &pb);
+    if (end && require_null_terminated) {
+      end = skip(end, &pb);
+      if (end < pb.end && *end) end = parse_error(&pb, end, cjson_Error_Syntax);
+    }
+    ctx->error_ptr = scratch.error_ptr;
+    ctx->error = scratch.error;
+  }
+  else {
+    ctx->error_ptr = value;
+    ctx->error = cjson_Error_Memory;
+  }
+  cjson_ArenaDestroy(scratch.arena);
+  if (!end) {
+    cjson_DocDelete(doc);
+    return 0;
+  }
+  if (return_parse_end) *return_parse_end = end;
+  return doc;
+}
+cjson_Doc *cjson_DocParse(const char *value) {
+  if (!value) return 0;
+  return cjson_DocParseWithLengthContext(&default_ctx, value, strlen(value), 0, 0);
+}
+
+/*把item自己复制成文档中的一个节点（容器不管子项），返回编号，失败返回0*/
+static unsigned doc_from_node(cjson_Doc *doc, cjson *item) {
+  unsigned i = doc_new_node(doc, item->type & 255);
+  cjson num;
+  char *tmp;
+  int ok;
+  if (!i) return 0;
+  if (item->type & cjson_IsLazy) {/*惰性的值转换到临时的地方，不改动树*/
+    if ((item->type & 255) == cjson_Number) {
+      num.type = 0;
+      lazy_number(item, &num);
+      doc->nodes[i].u.number = num.valuedouble;
+      return i;
+    }
+    if (!(tmp = (char *)doc->hooks.malloc_fn((size_t)item->valueint64 + 1))) return 0;
+    lazy_string(item, tmp);
+    ok = doc_set_string(doc, i, tmp);
+    doc->hooks.free_fn(tmp);
+    return ok ? i : 0;
+  }
+  switch (item->type & 255) {
+    case cjson_Number: doc->nodes[i].u.number = item->valuedouble; break;
+    case cjson_String: if (!doc_set_string(doc, i, item->valuestring ? item->valuestring : "")) return 0; break;
+  }
+  return i;
+}
+
+/*把item和它的子树复制到文档中，先序遍历，返回根的编号，失败返回0*/
+static unsigned doc_from_item(cjson_Doc *doc, cjson *item) {
+  doc_frame inline_frames[WALK_INLINE], *frames = inline_frames;
+  size_t size = WALK_INLINE, depth = 0;
+  unsigned i, key, root = 0;
+  cjson *c = item;
+  for (;;) {
+    key = 0;
+    if (!(i = doc_from_node(doc, c))
+        || (depth && c->string && !(key = doc_add_string(doc, c->string, strlen(c->string))))) {
+      root = 0;
+      break;
+    }
+    doc_attach(doc, frames, depth, &root, i, key);
+    if (((c->type & 255) == cjson_Array || (c->type & 255) == cjson_Object) && c->child) {/*进入子项*/
+      if (depth == size && !stack_grow(&doc->hooks, (void **)&frames, &size, inline_frames, sizeof(doc_frame))) {
+        root = 0;
+        break;
+      }
+      frames[depth].node = i;
+      frames[depth].last = 0;
+      frames[depth].item = c;
+      ++depth;
+      c = c->child;
+      continue;
+    }
+    while (depth && !c->next) c = frames[--depth].item;/*子项走完了，回到父容器*/
+    if (!depth) break;
+    c = c->next;
+  }
+  if (frames != inline_frames) doc->hooks.free_fn(frames);
+  return root;
+}
+
+cjson_Doc *cjson_DocFromTreeWithContext(cjson_Context *ctx, cjson *item) {
+  cjson_Doc *doc;
+  if (!item || !(doc = doc_create(ctx))) return 0;
+  if (!doc_from_item(doc, item)) {
+    cjson_DocDelete(doc);
+    return 0;
+  }
+  return doc;
+}
+cjson_Doc *cjson_DocFromTree(cjson *item) {return cjson_DocFromTreeWithContext(&default_ctx, item);}
+
+/*把文档中的ref号节点自己转换成cjson节点，容器不管子项*/
+static cjson *doc_to_node(cjson_Context *ctx, cjson_Doc *doc, unsigned ref) {
+  cjson *item;
+  switch (doc->nodes[ref].type & 255) {
+    case cjson_Number: return cjson_CreateNumberWithContext(ctx, doc->nodes[ref].u.number);
+    case cjson_String: return cjson_CreateStringWithContext(ctx, cjson_DocString(doc, ref));
+    case cjson_Array: return cjson_CreateArrayWithContext(ctx);
+    case cjson_Object: return cjson_CreateObjectWithContext(ctx);
+  }
+  if ((item = cjson_New_Item(ctx))) item->type |= doc->nodes[ref].type & 255;/*null、true、false*/
+  return item;
+}
+
+/*先序遍历ref的子树，每个节点建好就挂到父容器下面，失败时删掉已经建好的部分*/
+cjson *cjson_DocToTreeWithContext(cjson_Context *ctx, cjson_Doc *doc, cjson_DocRef ref) {
+  doc_frame inline_frames[WALK_INLINE], *frames = inline_frames;
+  size_t size = WALK_INLINE, depth = 0;
+  cjson *item, *root = 0;
+  unsigned c = ref;
+  if (!ctx || !doc || !ref || ref >= doc->nnodes) return 0;
+  for (;;) {
+    if (!(item = doc_to_node(ctx, doc, c))) break;
+    if (!depth) root = item;
+    else if (doc->nodes[c].key) cjson_AddItemToObjectWithContext(ctx, frames[depth - 1].item, cjson_DocKey(doc, c), item);
+    else cjson_AddItemToArray(frames[depth - 1].item, item);
+    if (cjson_DocSize(doc, c)) {/*进入子项*/
+      if (depth == size && !stack_grow(&ctx->hooks, (void **)&frames, &size, inline_frames, sizeof(doc_frame))) {
+        item = 0;
+        break;
+      }
+      frames[depth].node = c;
+      frames[depth].item = item;
+      ++depth;
+      c = doc->nodes[c].u.child;
+      continue;
+    }
+    while (depth && !doc->nodes[c].next) c = frames[--depth].node;/*子项走完了，回到父容器*/
+    if (!depth) break;
+    c = doc->nodes[c].next;
+  }
+  if (frames != inline_frames) ctx->hooks.free_fn(frames);
+  if (!item && root) {
+    cjson_DeleteWithContext(ctx, root);
+    root = 0;
+  }
+  return root;
+}
+cjson *cjson_DocToTree(cjson_Doc *doc, cjson_DocRef ref) {return cjson_DocToTreeWithContext(&default_ctx, doc, ref);}
+
+/*节点池和字符串池占用的字节数*/
+size_t cjson_DocMemorySize(cjson_Doc *doc) {
+  if (!doc) return 0;
+  return sizeof(cjson_Doc) + doc->nodes_cap * sizeof(doc_node) + doc->strings_cap;
+}
+
+/*访问文档，编号为0时相当于一个没有子项的空节点*/
+cjson_DocRef cjson_DocRoot(cjson_Doc *doc) {return doc->nnodes > 1 ? 1 : 0;}
+int cjson_DocType(cjson_Doc *doc, cjson_DocRef ref) {return doc->nodes[ref].type & 255;}
+double cjson_DocNumber(cjson_Doc *doc, cjson_DocRef ref) {
+  return (doc->nodes[ref].type & 255) == cjson_Number ? doc->nodes[ref].u.number : 0;
+}
+const char *cjson_DocString(cjson_Doc *doc, cjson_DocRef ref) {
+  doc_node *n = &doc->nodes[ref];
+  if ((n->type & 255) != cjson_String) return 0;
+  return (n->type & DOC_INLINE) ? n->u.inline_str : doc->strings + n->u.offset;
+}
+const char *cjson_DocKey(cjson_Doc *doc, cjson_DocRef ref) {
+  return doc->nodes[ref].key ? doc->strings + doc->nodes[ref].key - 1 : 0;
+}
+int cjson_DocSize(cjson_Doc *doc, cjson_DocRef ref) {
+  int type = doc->nodes[ref].type & 255;
+  return (type == cjson_Array || type == cjson_Object) ? (int)doc->nodes[ref].len : 0;
+}
+cjson_DocRef cjson_DocChild(cjson_Doc *doc, cjson_DocRef ref) {return cjson_DocSize(doc, ref) ? doc->nodes[ref].u.child : 0;}
+cjson_DocRef cjson_DocNext(cjson_Doc *doc, cjson_DocRef ref) {return doc->nodes[ref].next;}
+cjson_DocRef cjson_DocGetArrayItem(cjson_Doc *doc, cjson_DocRef ref, int item) {
+  cjson_DocRef c = cjson_DocChild(doc, ref);
+  if (item < 0) return 0;
+  while (c && item--) c = doc->nodes[c].next;
+  return c;
+}
+cjson_DocRef cjson_DocGetObjectItem(cjson_Doc *doc, cjson_DocRef ref, const char *string) {
+  cjson_DocRef c = cjson_DocChild(doc, ref);
+  while (c && (!doc->nodes[c].key || cjson_strcasecmp(doc->strings + doc->nodes[c].key - 1, string)))
+    c = doc->nodes[c].next;
+  return c;
+}
+
+/*
+  推式解析：输入一块一块地喂进来，不用先把整篇文档攒在一起。
+  容器用显式的栈记录，块的边界切开一个标量（字符串、数字、true/false/null）时，
+  只把这个标量已经收到的部分存进carry，等后面的块补齐了再用parse_string/parse_number解析。
+  解析完的树和cjson_ParseWithOpts(value, 0, 1)的一样
+*/
+#define PUSH_VALUE 0/*等一个值*/
+#define PUSH_ARRAY_FIRST 1/*'['之后，等值或者']'*/
+#define PUSH_OBJECT_FIRST 2/*'{'之后，等键名或者'}'*/
+#define PUSH_KEY 3/*对象里的','之后，等键名*/
+#define PUSH_COLON 4/*键名之后，等':'*/
+#define PUSH_NEXT 5/*容器里的值之后，等','或者结束符*/
+#define PUSH_DONE 6/*根已经完整，后面只能有空白*/
+
+struct cjson_PushParser
+{
+  cjson_Context *ctx;
+  cjson *root;
+  cjson **stack;/*还没结束的容器，栈顶是当前容器*/
+  size_t depth, stack_size;
+  int state;
+  int error;/*出错后一直保持，之后的输入都不再解析*/
+  char *carry;/*被块的边界切开的标量*/
+  size_t carry_len, carry_size;
+  int escape;/*carry中的字符串停在转义符后面*/
+};
+
+cjson_PushParser *cjson_PushParserCreateWithContext(cjson_Context *ctx) {
+  cjson_PushParser *pp;
+  if (!ctx) return 0;
+  if (!(pp = (cjson_PushParser *)cjson_malloc(ctx, sizeof(cjson_PushParser)))) return 0;
+  memset(pp, 0, sizeof(cjson_PushParser));
+  pp->ctx = ctx;
+  pp->state = PUSH_VALUE;
+  ctx->error_ptr = 0;
+  ctx->error = cjson_Error_None;
+  return pp;
+}
+cjson_PushParser *cjson_PushParserCreate(void) {return cjson_PushParserCreateWithContext(&default_ctx);}
+
+void cjson_PushParserDestroy(cjson_PushParser *pp) {
+  if (!pp) return;
+  if (pp->root) cjson_DeleteWithContext(pp->ctx, pp->root);
+  if (pp->stack) cjson_free(pp->ctx, pp->stack);
+  if (pp->carry) cjson_free(pp->ctx, pp->carry);
+  cjson_free(pp->ctx, pp);
+}
+
+static int push_error(cjson_PushParser *pp, const char *at, int error) {
+  pp->ctx->error_ptr = at;
+  pp->ctx->error = pp->error = error;
+  return error;
+}
+
+/*
+  从p开始找字符串结束的引号，找到返回引号后面的位置，没找到返回0。
+  *escape表示上一块停在转义符后面，p处的字符要跳过；没找到时更新它
+*/
+static const char *push_string_end(const char *p, const char *end, int *escape) {
+  if (*escape) {
+    if (p == end) return 0;
+    ++p;
+    *escape = 0;
   }
-  else {
-    /*分配空间*/
-    entrise = (char **)cjson_malloc(numentries * sizeof(char*));
-    if (!entrise) return 0;
-    names =   (char **) cjson_malloc(numentries * sizeof(char*));
-    if (!names) {
-      cjson_free(entrise);
+  while ((p = scan_string(p, end, 0)) < end) {
+    if (*p == '\"') return p + 1;
+    if (end - p < 2) {
+      *escape = 1;
       return 0;
     }
-    memset(entrise, 0, sizeof(char*) * numentries);
-    memset(names, 0, sizeof(char*) * numentries);
-    /*搜集全部字符串*/
-    child = item->child;
-    ++depth;
-    if (fmt) len += depth;
-    while (child) {
-      // printf("!!!\n");
-      names[i] = str = print_string_ptr(child->string, 0);
-      // printf("%s\n", str);//dug
-      entrise[i++] = ret = print_value(child, depth, fmt, 0);
-      if (str && ret) len += strlen(ret) + strlen(str) + 2 + (fmt ? 2+depth : 0);
-      else 
-        fail = 1;
-      child = child->next;
-    }
-    if (!fail) out = (char *) cjson_malloc(len);
-    if (!out) fail = 1;
-    /*错误处理*/
-    if (fail) {
-      for (i = 0; i < numentries; ++i) {
-        if (names[i]) cjson_free(names[i]);
-        if (entrise[i]) cjson_free(entrise[i]);
-      }
-      cjson_free(names);
-      cjson_free(entrise);
-      return 0;
-    }
-
-    /*构成输出*/
-    *out = '{';
-    ptr = out+1;
-    if (fmt) *ptr++ = '\n';
-    *ptr = 0;
-    for (i = 0; i < numentries; ++i) {
-      if (fmt)
-        for (j = 0; j < depth; ++j)
-          *ptr++ = '\t';
-      tmplen = strlen(names[i]);
-      memcpy(ptr, names[i], tmplen);
-      ptr += tmplen;
-      *ptr++ = ':';
-      if (fmt)
-        *ptr++ = '\t';
-      strcpy(ptr, entrise[i]);
-      ptr += strlen(entrise[i]);
-      if (i != numentries-1)
-        *ptr++ = ',';
-      if (fmt) *ptr++ = '\n';
-      *ptr = 0;
-      cjson_free(names[i]);
-      cjson_free(entrise[i]);
-    }
-    cjson_free(names);
-    cjson_free(entrise);
-    if (fmt) 
-      for (i = 0; i < depth-1; ++i) *ptr++ = '\t';
-    *ptr++ = '}';
-    *ptr++ = 0;
+    p += 2;
   }
-  return out;
+  return 0;
 }
 
+/*数字里可能出现的字节*/
+static const unsigned char number_chars[256] = {
+  ['0'] = 1, ['1'] = 1, ['2'] = 1, ['3'] = 1, ['4'] = 1, ['5'] = 1, ['6'] = 1, ['7'] = 1, ['8'] = 1, ['9'] = 1,
+  ['-'] = 1, ['+'] = 1, ['.'] = 1, ['e'] = 1, ['E'] = 1
+};
+#define is_number_char(c) (number_chars[(unsigned char)(c)])
 
-/*取得数组长度 取得索引项*/
-int cjson_GetArraySize(cjson *array) {
-  cjson *c = array->child;
-  int i = 0;
-  while (c)
-    c = c->next, ++i;
-  return i;
+/*
+  value处的标量在end之前是否完整，完整时返回结尾，否则返回0。
+  数字要看到后面一个不属于数字的字节才算完整，last表示end就是输入的结尾
+*/
+static const char *push_token_end(cjson_PushParser *pp, const char *value, const char *end, int last) {
+  const char *p;
+  switch (*value) {
+  case '\"':
+    pp->escape = 0;
+    return push_string_end(value + 1, end, &pp->escape);
+  case 't': case 'n':
+    return (end - value >= 4 || last) ? end : 0;
+  case 'f':
+    return (end - value >= 5 || last) ? end : 0;
+  }
+  for (p = value; p < end && is_number_char(*p); ++p);
+  return (p < end || last) ? p : 0;
 }
 
-cjson *cjson_GetArrayItem(cjson *array, int item) {
-  cjson *c = array->child;
-  while (c && item--)
-    c = c->next;
-  return c;
+/*把[p, end)追加到carry*/
+static int push_carry(cjson_PushParser *pp, const char *p, const char *end) {
+  size_t len = end - p;
+  if (pp->carry_len + len > pp->carry_size
+      && !buffer_grow(&pp->ctx->hooks, (void **)&pp->carry, &pp->carry_size, pp->carry_len + len, 1))
+    return 0;
+  memmove(pp->carry + pp->carry_len, p, len);
+  pp->carry_len += len;
+  return 1;
 }
 
-cjson *cjson_GetObjectItem(cjson *object, const char *string) {
-  cjson *c = object->child;
-  while (c && cjson_strcasecmp(c->string, string))
-    c = c->next;
-  return c;
+/*新值的节点：对象里的值用键名那里建好的节点，其它的新建一个挂到当前容器上*/
+static cjson *push_new_value(cjson_PushParser *pp) {
+  cjson *item, *top = pp->depth ? pp->stack[pp->depth - 1] : 0;
+  if (top && (top->type & 255) == cjson_Object) return top->child->prev;
+  if (!(item = cjson_New_Item(pp->ctx))) return 0;
+  if (top) cjson_AddItemToArray(top, item);
+  else pp->root = item;
+  return item;
 }
 
-/*添加后一个项*/
-static void suffix_object(cjson *prev, cjson *item) {
-  prev->next = item;
-  item->prev = prev;
+/*一个值结束之后的状态*/
+static void push_value_done(cjson_PushParser *pp) {pp->state = pp->depth ? PUSH_NEXT : PUSH_DONE;}
+
+/*解析[value, end)中一个完整的标量（键名或值），返回解析到的位置。字符串的end就在结束的引号后面*/
+static const char *push_token(cjson_PushParser *pp, const char *value, const char *end) {
+  parsebuffer pb = {0};
+  cjson *item, *top;
+  pb.ctx = pp->ctx;
+  pb.end = end;
+  if (pp->state == PUSH_KEY || pp->state == PUSH_OBJECT_FIRST) {
+    top = pp->stack[pp->depth - 1];
+    if (*value != '\"') return parse_error(&pb, value, cjson_Error_Syntax);
+    if (!(item = cjson_New_Item(pp->ctx))) return parse_error(&pb, value, cjson_Error_Memory);
+    cjson_AddItemToArray(top, item);
+    if (!(value = parse_string_body(item, value, end - 1, &pb))) return 0;
+    item->string = item->valuestring;
+    item->valuestring = 0;
+    item->type &= ~255;
+    pp->state = PUSH_COLON;
+    return value;
+  }
+  if (!(item = push_new_value(pp))) return parse_error(&pb, value, cjson_Error_Memory);
+  if (*value == '\"') value = parse_string_body(item, value, end - 1, &pb);/*push_token_end已经找到了结束的引号*/
+  else value = parse_value(item, value, &pb);
+  if (!value) return 0;
+  push_value_done(pp);
+  return value;
 }
 
-/*引用处理, 创建引用项*/
-static cjson *create_reference(cjson *item) {
-  cjson *ref = cjson_New_Item();
-  if (!ref) return 0;
-  memcpy(ref, item, sizeof(cjson));
-  ref->string = 0;
-  ref->type |= cjson_IsReference;
-  ref->next = ref->prev = 0;
-  return ref;
+/*结束栈顶的容器*/
+static void push_close(cjson_PushParser *pp) {
+  cjson *top = pp->stack[--pp->depth];
+  int option = ((top->type & 255) == cjson_Array) ? cjson_Option_IndexArrays : cjson_Option_IndexObjects;
+  if ((pp->ctx->options & option) && top->count >= CJSON_INDEX_THRESHOLD)
+    top->index = index_build(top, &pp->ctx->hooks, pp->ctx->arena);
+  push_value_done(pp);
 }
 
-/*添加项到数组或者对象的后面*/
-void cjson_AddItemToArray(cjson *array, cjson *item) {
-  cjson *c = array->child;
-  if (!item) return;
-  if (!c) array->child = item;
-  else {
-    while (c && c->next)
-      c = c->next;
-    suffix_object(c, item);
+/*解析[p, end)，last表示这是最后一块。被切开的标量存进carry*/
+static int push_parse(cjson_PushParser *pp, const char *p, const char *end, int last) {
+  const char *token_end;
+  cjson *item, *top;
+  char c;
+  while (p < end) {
+    if ((unsigned char)(*p - 1) < 32 && (p = skip_whitespace(p + 1, end)) == end) break;
+    c = *p;
+    top = pp->depth ? pp->stack[pp->depth - 1] : 0;
+    switch (pp->state) {
+    case PUSH_DONE:
+      return push_error(pp, p, cjson_Error_Syntax);
+    case PUSH_COLON:
+      if (c != ':') return push_error(pp, p, cjson_Error_Syntax);
+      pp->state = PUSH_VALUE;
+      ++p;
+      continue;
+    case PUSH_NEXT:
+      if (c == ',') pp->state = ((top->type & 255) == cjson_Object) ? PUSH_KEY : PUSH_VALUE;
+      else if (c == (((top->type & 255) == cjson_Object) ? '}' : ']')) push_close(pp);
+      else return push_error(pp, p, cjson_Error_Syntax);
+      ++p;
+      continue;
+    case PUSH_ARRAY_FIRST:
+    case PUSH_OBJECT_FIRST:
+      if (c == (pp->state == PUSH_OBJECT_FIRST ? '}' : ']')) {
+        push_close(pp);
+        ++p;
+        continue;
+      }
+      if (pp->state == PUSH_ARRAY_FIRST) pp->state = PUSH_VALUE;
+      break;
+    }
+    if (pp->state == PUSH_VALUE && (c == '[' || c == '{')) {/*进入下一层前检查嵌套深度*/
+      if (pp->ctx->max_depth && pp->depth >= (size_t)pp->ctx->max_depth)
+        return push_error(pp, p, cjson_Error_Depth);
+      if (pp->depth == pp->stack_size
+          && !buffer_grow(&pp->ctx->hooks, (void **)&pp->stack, &pp->stack_size, pp->depth + 1, sizeof(cjson *)))
+        return push_error(pp, p, cjson_Error_Memory);
+      if (!(item = push_new_value(pp))) return push_error(pp, p, cjson_Error_Memory);
+      item->type |= (c == '[') ? cjson_Array : cjson_Object;
+      pp->stack[pp->depth++] = item;
+      pp->state = (c == '[') ? PUSH_ARRAY_FIRST : PUSH_OBJECT_FIRST;
+      ++p;
+      continue;
+    }
+    if (!(token_end = push_token_end(pp, p, end, last)))/*标量被切开了*/
+      return push_carry(pp, p, end) ? cjson_Error_None : push_error(pp, p, cjson_Error_Memory);
+    if (!(p = push_token(pp, p, token_end))) return pp->error = pp->ctx->error;
   }
+  return cjson_Error_None;
 }
 
-void cjson_AddItemToObject(cjson *object, const char *string, cjson *item) {
-  if (!item) return;
-  if (item->string) cjson_free(item->string);
-  item->string = cjson_strdup(string);
-  cjson_AddItemToArray(object, item);
+/*先用data的开头补齐carry中的标量，再解析剩下的部分*/
+int cjson_PushParserFeed(cjson_PushParser *pp, const char *data, size_t len) {
+  const char *end = data + len, *p = data, *token_end;
+  int complete;
+  if (!pp || (!data && len)) return cjson_Error_Syntax;
+  if (pp->error) return pp->error;
+  if (pp->carry_len) {
+    switch (*pp->carry) {
+    case '\"':
+      complete = (token_end = push_string_end(data, end, &pp->escape)) != 0;
+      if (!complete) token_end = end;
+      break;
+    case 't': case 'n': case 'f':
+      len = (*pp->carry == 'f' ? 5 : 4) - pp->carry_len;
+      complete = (size_t)(end - data) >= len;
+      token_end = complete ? data + len : end;
+      break;
+    default:
+      for (token_end = data; token_end < end && is_number_char(*token_end); ++token_end);
+      complete = token_end < end;
+    }
+    if (!push_carry(pp, data, token_end)) return push_error(pp, data, cjson_Error_Memory);
+    if (!complete) return cjson_Error_None;
+    p = token_end;
+    len = pp->carry_len;
+    pp->carry_len = 0;
+    if (push_parse(pp, pp->carry, pp->carry + len, 1)) return pp->error;
+  }
+  return push_parse(pp, p, end, 0);
 }
-/*添加字符串常量的项*/
-void cjson_AddItemToObjectCS(cjson *object, const char *string, cjson *item) {
-  if (!item) return;
-  if (!(item->type & cjson_StringIsConst) && item->string)
-    cjson_free(item->string);
-  item->string = (char *)string;
-  item->type |= cjson_StringIsConst;
-  cjson_AddItemToArray(object, item);
+
+/*输入结束：解析carry中剩下的数字，文档完整时返回整棵树，由调用者释放*/
+cjson *cjson_PushParserFinish(cjson_PushParser *pp) {
+  cjson *root;
+  size_t len;
+  if (!pp || pp->error) return 0;
+  if (pp->carry_len) {
+    len = pp->carry_len;
+    pp->carry_len = 0;
+    if (push_parse(pp, pp->carry, pp->carry + len, 1)) return 0;
+  }
+  if (pp->state != PUSH_DONE) {/*文档不完整*/
+    push_error(pp, 0, cjson_Error_Syntax);
+    return 0;
+  }
+  root = pp->root;
+  pp->root = 0;
+  return root;
 }
 
-void cjson_AddItemReferenceToArray(cjson *array, cjson *item) {
-  cjson_AddItemToArray(array, create_reference(item));
+/*
+  SAX式解析：语法和parse_value一样，只是把建节点换成调用回调。
+  没有转义的字符串直接把输入中的一段交给回调，有转义时才去掉转义放进scratch。
+  和parse_value一样不递归，打开的容器记在stack里（'['或'{'，深度在pb.depth），
+  不深的文档用inline_stack，整个过程只有scratch和很深时的stack要分配
+*/
+typedef struct
+{
+  parsebuffer pb;
+  const cjson_SaxHandler *h;
+  void *user;
+  char *scratch;/*去掉转义后的字符串，只在回调期间有效*/
+  size_t scratch_size;
+  char *stack;/*打开的容器*/
+  size_t stack_size;
+  char inline_stack[WALK_INLINE];
+} saxparser;
+
+/*回调返回0：停止解析*/
+static const char *sax_stop(saxparser *sp, const char *at) {return parse_error(&sp->pb, at, cjson_Error_Stopped);}
+
+/*记下新打开的容器，内存不够返回0*/
+static int sax_push(saxparser *sp, char kind) {
+  if ((size_t)sp->pb.depth == sp->stack_size
+      && !stack_grow(&sp->pb.ctx->hooks, (void **)&sp->stack, &sp->stack_size, sp->inline_stack, 1))
+    return 0;
+  sp->stack[sp->pb.depth++] = kind;
+  return 1;
 }
-void cjson_AddItemReferenceToObject(cjson *array, const char *string, cjson *item) {
-  cjson_AddItemToObject(array, string, create_reference(item));
+
+/*解析一个字符串交给cb（键名或字符串值的回调），cb为空也要检查转义是否合法*/
+static const char *sax_string(saxparser *sp, const char *str, int (*cb)(void *, const char *, size_t)) {
+  parsebuffer *pb = &sp->pb;
+  const char *close, *s;
+  char *end;
+  size_t len;
+  if (peek(pb, str) != '\"')
+    return parse_error(pb, str, cjson_Error_Syntax);
+  if (!(close = string_close(str, pb->end)))
+    return parse_error(pb, str, cjson_Error_Syntax);
+  s = str + 1;
+  len = close - s;
+  stats_add(pb->ctx, strings, 1);
+  if (memchr(s, '\\', len)) {/*有转义，去掉转义放进scratch*/
+    stats_add(pb->ctx, strings_escaped, 1);
+    if (len > sp->scratch_size && !buffer_grow(&pb->ctx->hooks, (void **)&sp->scratch, &sp->scratch_size, len, 1))
+      return parse_error(pb, str, cjson_Error_Memory);
+    if (!(end = unescape_string(str, close, sp->scratch, pb))) return 0;
+    s = sp->scratch;
+    len = end - sp->scratch;
+  }
+  if (cb && !cb(sp->user, s, len)) return sax_stop(sp, str);
+  return close + 1;
 }
 
-cjson *cjson_DetachItemFromArray(cjson *array, int which) {
-  cjson *c = array->child;
-  while (c && which--) 
-    c = c->next;
-  if (!c) return 0;
-  if (c->prev)
-    c->prev->next = c->next;
-  if (c->next) 
-    c->next->prev = c->prev;
-  c->prev = c->next = 0;
-  return c;
+/*对象里的一个键名和后面的':'，返回值的开头*/
+static const char *sax_key(saxparser *sp, const char *value) {
+  parsebuffer *pb = &sp->pb;
+  value = skip(sax_string(sp, value, sp->h->key), pb);
+  if (!value) return 0;
+  if (peek(pb, value) != ':')
+    return parse_error(pb, value, cjson_Error_Syntax);
+  return skip(value + 1, pb);
 }
 
-void cjson_DeleteItemFromArray(cjson *array, int which) {
-  cjson_Delete(cjson_DetachItemFromArray(array, which));
+/*和parse_scalar一样按第一个字节分派*/
+static const char *sax_scalar(saxparser *sp, const char *value) {
+  parsebuffer *pb = &sp->pb;
+  const cjson_SaxHandler *h = sp->h;
+  const char *end;
+  cjson num;
+  switch (peek(pb, value)) {
+  case 'n':
+    if (!can_read(pb, value, 4) || memcmp(value, "null", 4)) break;
+    if (h->null && !h->null(sp->user)) return sax_stop(sp, value);
+    return value + 4;
+  case 'f':
+    if (!can_read(pb, value, 5) || memcmp(value, "false", 5)) break;
+    if (h->boolean && !h->boolean(sp->user, 0)) return sax_stop(sp, value);
+    return value + 5;
+  case 't':
+    if (!can_read(pb, value, 4) || memcmp(value, "true", 4)) break;
+    if (h->boolean && !h->boolean(sp->user, 1)) return sax_stop(sp, value);
+    return value + 4;
+  case '\"':
+    return sax_string(sp, value, h->string);
+  case '-': case '0': case '1': case '2': case '3': case '4':
+  case '5': case '6': case '7': case '8': case '9':
+    num.type = 0;/*数字借用栈上的节点解析*/
+    end = parse_number(&num, value, pb);
+    if (h->number && !h->number(sp->user, num.valuedouble, num.valueint64)) return sax_stop(sp, value);
+    return end;
+  }
+  return parse_error(pb, value, cjson_Error_Syntax);
 }
 
-cjson *cjson_DetachItemFromObject(cjson *object, const char *string) {
-  cjson *c = object->child;
-  while (c && cjson_strcasecmp(object->string, string))
-    c = c->next;
-  if (!c) return 0;
-  if (c->prev) c->prev->next = c->next;
-  if (c->next) c->next->prev = c->prev;
-  c->prev = c->next = 0;
-  return c;
+/*走一遍整个值，返回它后面（跳过空白）的位置，出错返回0*/
+static const char *sax_value(saxparser *sp, const char *value) {
+  parsebuffer *pb = &sp->pb;
+  const cjson_SaxHandler *h = sp->h;
+  char kind, close;
+  for (;;) {
+    value = skip(value, pb);
+    kind = peek(pb, value);
+    if (kind == '[' || kind == '{') {/*打开一个容器*/
+      if (pb->ctx->max_depth && pb->depth >= pb->ctx->max_depth)
+        return parse_error(pb, value, cjson_Error_Depth);
+      if (!sax_push(sp, kind))
+        return parse_error(pb, value, cjson_Error_Memory);
+      stats_depth(pb->ctx, pb->depth);
+      if (kind == '[' ? h->start_array && !h->start_array(sp->user) : h->start_object && !h->start_object(sp->user))
+        return sax_stop(sp, value);
+      value = skip(value + 1, pb);
+      if (peek(pb, value) != (kind == '[' ? ']' : '}')) {/*不是空容器，接着解析第一个子项*/
+        if (kind == '{' && !(value = sax_key(sp, value))) return 0;
+        continue;
+      }
+    }
+    else if (!(value = skip(sax_scalar(sp, value), pb))) return 0;
+    /*一个值结束了：逗号后面是同一层的下一个值，右括号关闭这一层，可能连着关闭好几层*/
+    for (;;) {
+      if (!pb->depth) return value;
+      kind = sp->stack[pb->depth - 1];
+      close = kind == '[' ? ']' : '}';
+      if (peek(pb, value) == ',') {
+        value = skip(value + 1, pb);
+        if (kind == '{' && !(value = sax_key(sp, value))) return 0;
+        break;
+      }
+      if (peek(pb, value) != close)
+        return parse_error(pb, value, cjson_Error_Syntax);
+      --pb->depth;
+      if (close == ']' ? h->end_array && !h->end_array(sp->user) : h->end_object && !h->end_object(sp->user))
+        return sax_stop(sp, value);
+      value = skip(value + 1, pb);
+    }
+  }
 }
 
-void cjson_DeleteItemFromObject(cjson *object, const char *string) {
-  cjson_Delete(cjson_DetachItemFromObject(object, string));
+int cjson_SaxParseWithContext(cjson_Context *ctx, const char *value, size_t buffer_length, const cjson_SaxHandler *handler, void *user) {
+  saxparser sp;
+  const char *end;
+  unsigned long long t0;
+  if (!ctx || !value || !handler) return cjson_Error_Syntax;
+  t0 = stats_start(ctx);
+  memset(&sp, 0, sizeof(sp));
+  sp.pb.ctx = ctx;
+  sp.pb.end = value + buffer_length;
+  sp.h = handler;
+  sp.user = user;
+  sp.stack = sp.inline_stack;
+  sp.stack_size = WALK_INLINE;
+  ctx->error_ptr = 0;
+  ctx->error = cjson_Error_None;
+  end = sax_value(&sp, value);
+  if (end && end < sp.pb.end && *end)/*根后面还有别的内容*/
+    parse_error(&sp.pb, end, cjson_Error_Syntax);
+  if (sp.scratch) cjson_free(ctx, sp.scratch);
+  if (sp.stack != sp.inline_stack) cjson_free(ctx, sp.stack);
+  stats_add(ctx, parses, 1);
+  stats_time(ctx, parse_ns, t0);
+  return ctx->error;
+}
+int cjson_SaxParse(const char *value, size_t buffer_length, const cjson_SaxHandler *handler, void *user) {
+  return cjson_SaxParseWithContext(&default_ctx, value, buffer_length, handler, user);
 }
-/*插入在which区域，原来的后移*/
-void cjson_InsertItemInArray(cjson *array, int which, cjson *newitem) {
-  cjson *c = array->child;
-  while (c && which--) c = c->next;
-  if (!c) {
-    cjson_AddItemToArray(array, newitem);
-    return;
-  }
 
-  suffix_object(newitem, c);
-  if (c != array->child)
-    suffix_object(c->prev, newitem);
-  else {
-    newitem->prev = c->prev;
-    array->child = newitem;
+/*
+  批量解析：一个缓冲或者一个流里有很多篇文档，cjson_BatchNext每次解析一篇。
+  所有文档都放在批量解析器自己的arena里，每次Next先把arena清空，分配的内存在文档之间反复使用。
+  一篇出错不影响后面的：从这一篇开头之后的下一个换行继续
+*/
+#define BATCH_READ 4096/*流模式每次至少读这么多*/
+
+struct cjson_Batch
+{
+  cjson_Context ctx;/*调用者上下文的副本，arena换成自己的*/
+  cjson_Context *user_ctx;/*错误也抄一份回调用者的上下文*/
+  cjson_Arena *arena;
+  const char *data;/*缓冲模式是调用者的输入，流模式是buf*/
+  size_t pos, len;/*已经处理到data的哪里，data的长度*/
+  size_t base;/*data[0]在整个输入中的偏移，流模式丢掉已经解析的部分后增加*/
+  size_t offset, error_offset;/*上一篇文档和它出错的位置在整个输入中的偏移*/
+  cjson_ReadFn read;/*不为空时是流模式，每行一篇文档*/
+  void *user;
+  char *buf;
+  size_t size;
+  int eof;
+};
+
+static cjson_Batch *batch_create(cjson_Context *ctx) {
+  cjson_Batch *b;
+  if (!ctx) return 0;
+  if (!(b = (cjson_Batch *)cjson_malloc(ctx, sizeof(cjson_Batch)))) return 0;
+  memset(b, 0, sizeof(cjson_Batch));
+  b->ctx = *ctx;
+  b->user_ctx = ctx;
+  if (!(b->ctx.arena = b->arena = cjson_ArenaCreateWithContext(ctx, 0))) {
+    cjson_free(ctx, b);
+    return 0;
   }
+  return b;
 }
-/*替换取代原来的cjson，原来的内存要清理*/
-void cjson_ReplaceItemInArray(cjson *array, int which, cjson *newitem) {
-  cjson *c;
-  if (!(c = cjson_GetArrayItem(array, which))) return;
-  newitem->prev = c->prev;
-  newitem->next = c->next;
-  if (c == array->child) array->child = newitem;
-  else c->prev->next = newitem;
-  if (c->next) c->next->prev = newitem;
-  c->next = c->prev = 0;
-  cjson_Delete(c);
+cjson_Batch *cjson_BatchCreateWithContext(cjson_Context *ctx, const char *data, size_t len) {
+  cjson_Batch *b;
+  if (!data || !(b = batch_create(ctx))) return 0;
+  b->data = data;
+  b->len = len;
+  return b;
 }
-
-void cjson_ReplaceItemInObject(cjson *object, const char *string, cjson *newitem) {
-  cjson *c = cjson_GetObjectItem(object, string);
-  if (!c) return;
-  if (newitem->string) cjson_free(newitem->string);//自己改动
-  newitem->string = cjson_strdup(string);
-  newitem->prev = c->prev;
-  newitem->next = c->next;
-  if (c == object->child) object->child = newitem;
-  else c->prev->next = newitem;
-  if (c->next)  c->next->prev = newitem;
-  c->next = c->prev = 0;
-  cjson_Delete(c);
+cjson_Batch *cjson_BatchCreate(const char *data, size_t len) {return cjson_BatchCreateWithContext(&default_ctx, data, len);}
+cjson_Batch *cjson_BatchCreateWithReader(cjson_Context *ctx, cjson_ReadFn read, void *user) {
+  cjson_Batch *b;
+  if (!read || !(b = batch_create(ctx))) return 0;
+  b->read = read;
+  b->user = user;
+  return b;
 }
+static size_t file_read(void *user, char *data, size_t len) {return fread(data, 1, len, (FILE *)user);}
+cjson_Batch *cjson_BatchCreateFromFile(FILE *fp) {return fp ? cjson_BatchCreateWithReader(&default_ctx, file_read, fp) : 0;}
 
-/*创建基本类型*/
-cjson *cjson_CreateNull(void) {
-  cjson *item = cjson_New_Item();
-  if (item) item->type = cjson_Null;
-  return item;
+void cjson_BatchDestroy(cjson_Batch *b) {
+  if (!b) return;
+  cjson_ArenaDestroy(b->arena);
+  if (b->buf) cjson_free(b->user_ctx, b->buf);
+  cjson_free(b->user_ctx, b);
 }
 
-cjson *cjson_CreateTrue(void) {
-  cjson *item = cjson_New_Item();
-  if (item) item->type = cjson_True;
-  return item;
+/*流模式：丢掉已经解析过的部分，再读一块。内存不够返回0*/
+static int batch_fill(cjson_Batch *b) {
+  size_t n;
+  if (b->pos) {
+    memmove(b->buf, b->buf + b->pos, b->len - b->pos);
+    b->len -= b->pos;
+    b->base += b->pos;
+    b->pos = 0;
+  }
+  if (b->size - b->len < BATCH_READ && !buffer_grow(&b->ctx.hooks, (void **)&b->buf, &b->size, b->len + BATCH_READ, 1)) return 0;
+  b->data = b->buf;
+  n = b->read(b->user, b->buf + b->len, b->size - b->len);
+  if (!n) b->eof = 1;
+  b->len += n;
+  return 1;
 }
-
-cjson *cjson_CreateFalse(void) {
-  cjson *item = cjson_New_Item();
-  if (item) item->type = cjson_False;
-  return item;
+/*流模式：读到pos开始的一整行（或者流结束），返回行尾的位置，内存不够返回0*/
+static const char *batch_line(cjson_Batch *b) {
+  const char *nl;
+  size_t scanned = 0;/*已经找过没有换行的部分*/
+  for (;;) {
+    if (b->len > b->pos + scanned && (nl = (const char *)memchr(b->data + b->pos + scanned, '\n', b->len - b->pos - scanned))) return nl;
+    if (b->eof) return b->data + b->len;
+    scanned = b->len - b->pos;
+    if (!batch_fill(b)) return 0;
+  }
 }
 
-cjson *cjson_CreateBool(int b) {
-  cjson *item = cjson_New_Item();
-  if (item) item->type = b ? cjson_True : cjson_False;
-  return item;
+/*
+  取下一篇文档，没有了返回0。否则返回1，*doc是解析出来的树，出错时为0。
+  树在下一次cjson_BatchNext之前有效，不要cjson_Delete
+*/
+int cjson_BatchNext(cjson_Batch *b, cjson **doc) {
+  parsebuffer pb = {0};
+  const char *start, *stop, *end = 0, *nl;
+  *doc = 0;
+  if (!b) return 0;
+  cjson_ArenaReset(b->arena);
+  for (;;) {/*跳过空白（流模式里是空行）*/
+    if (!b->read) stop = b->data + b->len;
+    else if (!(stop = batch_line(b))) {/*一行太长，内存不够，后面的都不解析了*/
+      b->ctx.error_ptr = 0;
+      b->ctx.error = cjson_Error_Memory;
+      b->error_offset = b->offset = b->base + b->pos;
+      b->pos = b->len;
+      b->eof = 1;
+      b->user_ctx->error_ptr = 0;
+      b->user_ctx->error = cjson_Error_Memory;
+      return 1;
+    }
+    start = skip_whitespace(b->data + b->pos, stop);
+    if (start < stop) break;
+    if (stop == b->data + b->len) {
+      b->pos = b->len;
+      return 0;
+    }
+    b->pos = stop + 1 - b->data;
+  }
+  b->offset = b->base + (start - b->data);
+  pb.ctx = &b->ctx;
+  pb.end = stop;
+  *doc = parse_root(start, &end, b->read != 0, &pb);/*流模式一行只能有一篇*/
+  b->user_ctx->error_ptr = b->ctx.error_ptr;
+  b->user_ctx->error = b->ctx.error;
+  if (*doc && !b->read) b->pos = end - b->data;/*首尾相接的下一篇紧接着开始*/
+  else if (b->read) b->pos = stop - b->data + (stop < b->data + b->len);
+  else {/*出错了，从下一行继续*/
+    nl = (const char *)memchr(start, '\n', stop - start);
+    b->pos = nl ? (size_t)(nl + 1 - b->data) : b->len;
+  }
+  if (!*doc) b->error_offset = b->base + (b->ctx.error_ptr - b->data);
+  return 1;
 }
+/*上一篇文档开头的偏移；出错时的错误码和出错位置的偏移*/
+size_t cjson_BatchOffset(cjson_Batch *b) {return b->offset;}
+int cjson_BatchError(cjson_Batch *b) {return b->ctx.error;}
+size_t cjson_BatchErrorOffset(cjson_Batch *b) {return b->error_offset;}
 
-cjson *cjson_CreateNumber(double num) {
-  cjson *item = cjson_New_Item();
-  if (item) {
-    item->type = cjson_Number;
-    cjson_SetNumberValue(item, num);
+/*
+  并行解析：把NDJSON按行、或者把一个很大的顶层数组按元素切成几段，每段在一个线程上解析，
+  最后按原来的顺序接成一个数组。每个线程用自己的上下文副本，上下文带arena时每个线程用自己的arena，
+  解析完再把这些arena的块并进调用者的arena，线程之间不共享任何可变的状态。
+  钩子的malloc和free必须是线程安全的
+*/
+#ifndef CJSON_MAX_THREADS
+#define CJSON_MAX_THREADS 64
+#endif
+#ifndef CJSON_PARALLEL_MIN_CHUNK
+#define CJSON_PARALLEL_MIN_CHUNK (64 * 1024)/*每个线程至少分到这么多字节，否则不值得开线程*/
+#endif
+
+typedef struct
+{
+  cjson_Context ctx;/*这个线程自己的上下文*/
+  const char *start, *end;/*要解析的范围*/
+  int lines;/*1：每行一篇文档；0：数组中用','隔开的一段元素*/
+  cjson *first, *last;/*解析出来的子链*/
+  int count;
+  cjson_Stats stats;/*这个线程的统计，结束后加到调用者的上下文*/
+} parse_job;
+
+static void job_link(parse_job *job, cjson *c) {
+  if (job->last) job->last->next = c, c->prev = job->last;
+  else job->first = c;
+  job->last = c;
+  ++job->count;
+}
+/*解析数组中的一段元素*/
+static void parse_job_elements(parse_job *job, parsebuffer *pb) {
+  const char *p;
+  cjson *c;
+  pb->depth = 1;/*在根数组里面*/
+  stats_depth(pb->ctx, 1);
+  p = skip(job->start, pb);
+  for (;;) {
+    if (!(c = cjson_New_Item(&job->ctx))) {
+      parse_error(pb, p, cjson_Error_Memory);
+      return;
+    }
+    job_link(job, c);
+    if (!(p = skip(parse_value(c, p, pb), pb))) return;
+    if (p >= job->end) return;
+    if (*p != ',') {
+      parse_error(pb, p, cjson_Error_Syntax);
+      return;
+    }
+    p = skip(p + 1, pb);
   }
-  return item;
+}
+/*解析一段，出错时错误记录在job->ctx中，已经解析的部分留在子链上由调用者释放*/
+static void parse_job_run(parse_job *job) {
+  parsebuffer pb = {0};
+  const char *p = job->start, *stop;
+  unsigned long long t0;
+  cjson *c;
+  pb.ctx = &job->ctx;
+  pb.end = job->end;
+  pb.lazy = job->ctx.options & cjson_Option_Lazy;
+  if (job->lines) {
+    for (;;) {
+      if (!(stop = (const char *)memchr(p, '\n', job->end - p))) stop = job->end;
+      if (skip_whitespace(p, stop) < stop) {/*跳过空行*/
+        pb.end = stop;
+        if (!(c = parse_root(p, 0, 1, &pb))) return;
+        job_link(job, c);
+      }
+      if (stop == job->end) return;
+      p = stop + 1;
+    }
+  }
+  t0 = stats_start(&job->ctx);
+  parse_job_elements(job, &pb);
+  stats_time(&job->ctx, parse_ns, t0);
 }
 
-cjson *cjson_CreateString(const char *string) {
-  cjson *item = cjson_New_Item();
-  if (item) {
-    item->type = cjson_String;
-    item->valuestring = cjson_strdup(string);
+#ifdef CJSON_THREADS
+static void *parse_job_thread(void *job) {
+  parse_job_run((parse_job *)job);
+  return 0;
+}
+#endif
+/*jobs[0]在当前线程上跑，其它的各开一个线程，开不了的也在当前线程上跑*/
+static void run_jobs(parse_job *jobs, int n) {
+  int i;
+#ifdef CJSON_THREADS
+  pthread_t tid[CJSON_MAX_THREADS];
+  int started[CJSON_MAX_THREADS];
+  for (i = 1; i < n; ++i) started[i] = !pthread_create(&tid[i], 0, parse_job_thread, &jobs[i]);
+  parse_job_run(&jobs[0]);
+  for (i = 1; i < n; ++i) {
+    if (started[i]) pthread_join(tid[i], 0);
+    else parse_job_run(&jobs[i]);
   }
-  return item;
+#else
+  for (i = 0; i < n; ++i) parse_job_run(&jobs[i]);
+#endif
 }
 
-cjson *cjson_CreateArray(void) {
-  cjson *item = cjson_New_Item();
-  if (item) item->type = cjson_Array;
-  return item;
+/*线程数：不超过CJSON_MAX_THREADS，每个线程至少CJSON_PARALLEL_MIN_CHUNK字节，0表示CPU的个数*/
+static int parallel_threads(int threads, size_t len) {
+#if defined(CJSON_THREADS) && defined(_SC_NPROCESSORS_ONLN)
+  if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  if (threads > CJSON_MAX_THREADS) threads = CJSON_MAX_THREADS;
+  if ((size_t)threads > len / CJSON_PARALLEL_MIN_CHUNK) threads = (int)(len / CJSON_PARALLEL_MIN_CHUNK);
+  return threads > 1 ? threads : 1;
 }
 
-cjson *cjson_CreateObject(void) {
-  cjson *item = cjson_New_Item();
-  if (item) item->type = cjson_Object;
-  return item;
+/*
+  把from的块都接到into当前块的后面，from中的树从此归into管，之后into的分配从from的当前块继续。
+  from本身释放掉
+*/
+static void arena_merge(cjson_Arena *into, cjson_Arena *from) {
+  arena_chunk *last = from->current;
+  while (last->next) last = last->next;
+  last->next = into->current->next;
+  into->current->next = from->head;
+  into->current = from->current;
+  from->hooks.free_fn(from);
 }
 
-/* 创建数组 */
-cjson *cjson_CreateIntArray(const int *numbers, int count) {
-  int i;
-  cjson *now = 0, *prev = 0, *array = cjson_CreateArray();
-  for (i = 0; array && i < count; ++i) {
-    now = cjson_CreateNumber(numbers[i]);
-    if (!i) array->child = now;
-    else suffix_object(prev, now);
-    prev = now;
-  }
-  return array;
-}//其实这个直接写cjson_CreateDoubleArray(numbers, count)也没事
+/*把一个线程的统计加到into*/
+static void stats_merge(cjson_Stats *into, const cjson_Stats *from) {
+  into->nodes += from->nodes;
+  into->allocs += from->allocs;
+  into->bytes += from->bytes;
+  into->arena_bytes += from->arena_bytes;
+  into->buffer_grows += from->buffer_grows;
+  into->strings += from->strings;
+  into->strings_escaped += from->strings_escaped;
+  if (from->max_depth > into->max_depth) into->max_depth = from->max_depth;
+  into->parses += from->parses;
+  into->prints += from->prints;
+  into->deletes += from->deletes;
+  into->parse_ns += from->parse_ns;
+  into->print_ns += from->print_ns;
+  into->delete_ns += from->delete_ns;
+}
 
-cjson *cjson_CreateDoubleArray(const double *numbers, int count) {
-  int i;
-  cjson *now = 0, *prev = 0, *array = cjson_CreateArray();
-  for (i = 0; array && i < count; ++i) {
-    now = cjson_CreateNumber(numbers[i]);
-    if (!i) array->child = now;
-    else suffix_object(prev, now);
-    prev = now;
+/*
+  跑完jobs后接成一个数组。有一段出错时返回0，错误记在ctx中（第一段出错的），
+  已经解析的部分都释放掉。arena是各段自己的arena，成功时并进ctx->arena。
+  各段的统计也只在成功时并进ctx->stats：失败后还要串行重新解析，不能把同样的工作记两遍
+*/
+static cjson *parallel_finish(cjson_Context *ctx, parse_job *jobs, int n) {
+  cjson *root = 0, *last = 0;
+  int i, failed = -1;
+  for (i = 0; i < n && failed < 0; ++i)
+    if (jobs[i].ctx.error) failed = i;
+  if (failed < 0 && !(root = cjson_New_Item(ctx))) failed = n;
+  if (failed >= 0) {
+    if (failed < n) {
+      ctx->error_ptr = jobs[failed].ctx.error_ptr;
+      ctx->error = jobs[failed].ctx.error;
+    }
+    else ctx->error = cjson_Error_Memory;
+    for (i = 0; i < n; ++i) {
+      if (ctx->arena) cjson_ArenaDestroy(jobs[i].ctx.arena);
+      else delete_list(ctx, jobs[i].first);
+    }
+    return 0;
   }
-  return array;
+  if (ctx->stats) for (i = 0; i < n; ++i) stats_merge(ctx->stats, &jobs[i].stats);
+  root->type = cjson_Array | (root->type & (cjson_IsArena|cjson_IsPooled));
+  for (i = 0; i < n; ++i) {
+    if (ctx->arena) arena_merge(ctx->arena, jobs[i].ctx.arena);
+    if (!jobs[i].first) continue;
+    if (last) last->next = jobs[i].first, jobs[i].first->prev = last;
+    else root->child = jobs[i].first;
+    last = jobs[i].last;
+    root->count += jobs[i].count;
+  }
+  if (root->child) root->child->prev = last;
+  if ((ctx->options & cjson_Option_IndexArrays) && root->count >= CJSON_INDEX_THRESHOLD)
+    root->index = index_build(root, &ctx->hooks, ctx->arena);
+  return root;
 }
 
-cjson *cjson_CreateStringArray(const char **strings, int count) {
+/*准备n段的上下文，带arena时每段建一个自己的arena，失败返回0*/
+static int parallel_jobs(cjson_Context *ctx, parse_job *jobs, int n) {
   int i;
-  cjson *now = 0, *prev = 0, *array = cjson_CreateArray();
-  for (i = 0; array && i < count; ++i) {
-    now = cjson_CreateString(strings[i]);
-    if (!i) array->child = now;
-    else suffix_object(prev, now);
-    prev = now;
+  memset(jobs, 0, n * sizeof(parse_job));
+  for (i = 0; i < n; ++i) {
+    jobs[i].ctx = *ctx;
+    if (ctx->stats) jobs[i].ctx.stats = &jobs[i].stats;
+    if (ctx->pool && !ctx->pool->shared) jobs[i].ctx.pool = 0;/*只给一个线程用的池，各段从钩子分配*/
+    if (ctx->arena && !(jobs[i].ctx.arena = cjson_ArenaCreateWithContext(ctx, 0))) {
+      while (i--) cjson_ArenaDestroy(jobs[i].ctx.arena);
+      ctx->error_ptr = 0;
+      ctx->error = cjson_Error_Memory;
+      return 0;
+    }
   }
-  return array;
+  return 1;
 }
 
-/* 复制 */
-cjson *cjson_Duplicate(cjson *item, int recurse) {
-  cjson *newitem, *cptr, *nptr = 0, *newchild;
-  /*局部变量
-    newitem : 复制出来的新项
-    cptr : 指向原来item的子项遍历
-    nptr : 指向当前处理的指针的前一个,也就是上一项
-    newchild : 复制出来的新儿子项，也就是当前处理项
-  */
-  if (!item) return 0;
-  newitem = cjson_New_Item();/*创建新项*/
-  if (!newitem) return 0;
-  /*拷贝所有值*/
-  newitem->type = item->type & (~cjson_IsReference),
-  newitem->valueint = item->valueint,
-  newitem->valuedouble = item->valuedouble;
-  if (item->valuestring) {
-    newitem->valuestring = cjson_strdup(item->valuestring);
-    if (!newitem->valuestring) {
-      cjson_Delete(newitem);
-      return 0;
-    }
+/*NDJSON：在大约平均的位置往后找换行切开，每个线程解析若干整行*/
+cjson *cjson_ParseLinesParallelWithContext(cjson_Context *ctx, const char *value, size_t buffer_length, int threads) {
+  parse_job jobs[CJSON_MAX_THREADS];
+  const char *p, *end, *nl;
+  int i, n;
+  if (!ctx || !value) return 0;
+  ctx->error_ptr = 0;
+  ctx->error = cjson_Error_None;
+  n = parallel_threads(threads, buffer_length);
+  if (!parallel_jobs(ctx, jobs, n)) return 0;
+  end = value + buffer_length;
+  for (p = value, i = 0; i < n; ++i) {
+    jobs[i].lines = 1;
+    jobs[i].start = p;
+    nl = (i == n - 1) ? 0 : (const char *)memchr(value + buffer_length / n * (i + 1), '\n', end - (value + buffer_length / n * (i + 1)));
+    if (nl && nl < p) nl = (const char *)memchr(p, '\n', end - p);/*上一段的行很长，已经越过了这里*/
+    p = nl ? nl + 1 : end;
+    jobs[i].end = nl ? nl : end;
   }
-  if (item->string) {
-    newitem->string = cjson_strdup(item->string);
-    if (!newitem->string) {
-      cjson_Delete(newitem);
-      return 0;
+  run_jobs(jobs, n);
+  return parallel_finish(ctx, jobs, n);
+}
+cjson *cjson_ParseLinesParallel(const char *value, size_t buffer_length, int threads) {
+  return cjson_ParseLinesParallelWithContext(&default_ctx, value, buffer_length, threads);
+}
+
+/*会改变嵌套或者要跳过的字节*/
+static const unsigned char structural_chars[256] = {
+  ['"'] = 1, [','] = 1, ['['] = 1, [']'] = 1, ['{'] = 1, ['}'] = 1
+};
+/*
+  在根数组里找顶层的','，把元素大约平均地分成n段，cuts记下每一刀的','。
+  只跟踪字符串和嵌套，不做转换；数组的写法不对或者后面还有别的内容时返回0，交给串行解析报错
+*/
+static int split_array(const char *p, const char *end, int n, const char **cuts, const char **close) {
+  size_t step = (end - p) / n;
+  const char *next = p + step;
+  int depth = 0, found = 0;
+  for (;;) {
+    while (p < end && !structural_chars[(unsigned char)*p]) ++p;
+    if (p >= end) return 0;
+    switch (*p) {
+    case '"':
+      if (!(p = string_close(p, end))) return 0;
+      break;
+    case '[': case '{':
+      ++depth;
+      break;
+    case ']': case '}':
+      if (!depth) {
+        if (*p != ']') return 0;
+        *close = p;
+        p = skip_whitespace(p + 1, end);
+        return (p == end || !*p) ? found : 0;
+      }
+      --depth;
+      break;
+    case ',':
+      if (!depth && p >= next && found < n - 1) {
+        cuts[found++] = p;
+        next = p + step;
+      }
+      break;
     }
+    ++p;
   }
-  /*如果是非递归拷贝所有儿子的*/
-  if (!recurse) return newitem;
-  cptr = item->child;
-  while (cptr) {
-    newchild = cjson_Duplicate(cptr, 1);
-    if (!newchild) {
-      cjson_Delete(newitem);
-      return 0;
+}
+
+/*
+  根是数组时把它的元素分给几个线程解析，其它情况和cjson_ParseWithLengthContext(ctx, value, buffer_length, 0, 1)一样。
+  任何一段出错都换成串行解析，报告的错误和串行解析的完全相同
+*/
+cjson *cjson_ParseParallelWithContext(cjson_Context *ctx, const char *value, size_t buffer_length, int threads) {
+  parse_job jobs[CJSON_MAX_THREADS];
+  const char *cuts[CJSON_MAX_THREADS], *start, *close = 0, *end;
+  cjson *root;
+  int i, n;
+  if (!ctx || !value) return 0;
+  ctx->error_ptr = 0;
+  ctx->error = cjson_Error_None;
+  end = value + buffer_length;
+  start = skip_whitespace(value, end);
+  n = parallel_threads(threads, buffer_length);
+  if (n > 1 && start < end && *start == '[') {
+    n = split_array(start + 1, end, n, cuts, &close) + 1;
+    if (close && n > 1 && parallel_jobs(ctx, jobs, n)) {
+      for (i = 0; i < n; ++i) {
+        jobs[i].start = i ? cuts[i - 1] + 1 : start + 1;
+        jobs[i].end = i < n - 1 ? cuts[i] : close;
+      }
+      run_jobs(jobs, n);
+      if ((root = parallel_finish(ctx, jobs, n))) {
+        stats_add(ctx, parses, 1);
+        return root;
+      }
     }
-    if (nptr) /*连接*/
-      suffix_object(nptr, newchild);
-    else
-      newitem->child = newchild;/*第一项*/
-    nptr = newchild;
-    cptr = cptr->next;
   }
-  return newitem;
+  return cjson_ParseWithLengthContext(ctx, value, buffer_length, 0, 1);
 }
+cjson *cjson_ParseParallel(const char *value, size_t buffer_length, int threads) {
+  return cjson_ParseParallelWithContext(&default_ctx, value, buffer_length, threads);
+}
+
 /*文本处理将注释和多余没用的空格处理掉*/
 void cjson_Minify(char *json) {
   char *into = json;
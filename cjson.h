@@ -2,6 +2,8 @@
 #ifndef cjson_h
 #define cjson_h
 
+#include <stdio.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -17,16 +19,22 @@ extern "C" {
 
 #define cjson_IsReference 256 //是一个引用
 #define cjson_StringIsConst 512 //常量字符串
+#define cjson_IsArena 1024 //节点和它的字符串分配在arena中
+#define cjson_IsLazy 2048 //惰性解析的值还没有转换，要用cjson_Get*Value取值
+#define cjson_IsPooled 4096 //节点从节点池中分配
 
 typedef struct cjson
 {
-    struct cjson *next, *prev; //用于数组或对象的链
+    struct cjson *next, *prev; //用于数组或对象的链，第一个子项的prev指向最后一个子项
     struct cjson *child; //孩子指针指向数组或对象中的子链
+    struct cjson_index *index; //大对象的键名哈希索引或大数组的下标索引，解析时或cjson_BuildIndex建立，不要直接修改
+    int count; //数组或对象的子项数，由各个接口维护，直接改子链时要自己更新
 
     int type; //cjson类型
 
     char *valuestring; /*如果类型为string，string值*/
-    int valueint; /*同理类型为int，int值*/
+    int valueint; /*同理类型为int，int值，超出int范围时取INT_MAX或INT_MIN*/
+    long long valueint64; /*64位整数值，整数在64位范围内时是精确的，超出范围时取最大或最小值*/
     double valuedouble; /*同上*/
     
     char *string; /*如果此项是对象的子项或子列表，表示该项的名字*/
@@ -40,6 +48,107 @@ typedef struct cjson_Hooks
 /*提供malloc，realloc和free函数*/
 extern void cjson_InitHooks(cjson_Hooks *hooks);
 
+typedef struct cjson_Arena cjson_Arena;
+typedef struct cjson_Pool cjson_Pool;
+
+/*错误码*/
+#define cjson_Error_None 0
+#define cjson_Error_Syntax 1 //语法错误
+#define cjson_Error_Memory 2 //内存分配失败
+#define cjson_Error_Depth 3 //嵌套超过max_depth
+#define cjson_Error_Stopped 4 //SAX回调返回0要求停止
+
+/*cjson_Context.options*/
+#define cjson_Option_IndexObjects 1 //解析时就给大对象建立键名索引
+#define cjson_Option_IndexArrays 2 //解析时就给大数组建立下标索引
+#define cjson_Option_Lazy 4 //惰性解析：字符串值和数字只记录原文的位置，取值时才转换
+
+/*对象或数组的子项达到这么多时才建立索引*/
+#ifndef CJSON_INDEX_THRESHOLD
+#define CJSON_INDEX_THRESHOLD 16
+#endif
+
+/*cjson_InitContext设置的默认最大嵌套深度*/
+#ifndef CJSON_NESTING_LIMIT
+#define CJSON_NESTING_LIMIT 1000
+#endif
+
+/*
+  统计：编译时定义CJSON_STATS才会记录，否则计数一直是0，没有额外开销。
+  把cjson_Stats挂到上下文的stats上，用这个上下文的解析、输出、删除都记在里面；
+  用cjson_GetStats取一份快照，cjson_ResetStats清零。同一个cjson_Stats不要在多个线程里同时使用
+*/
+typedef struct cjson_Stats
+{
+    size_t nodes; /*创建的节点数*/
+    size_t allocs; /*通过钩子申请内存的次数*/
+    size_t bytes; /*通过钩子申请的字节数*/
+    size_t arena_bytes; /*从arena中分配的字节数*/
+    size_t buffer_grows; /*输出时缓冲扩大重新分配的次数*/
+    size_t strings; /*解析的字符串数（含键名）*/
+    size_t strings_escaped; /*其中带转义、需要转换的*/
+    int max_depth; /*解析时到达过的最大嵌套深度*/
+    size_t parses, prints, deletes; /*解析、输出、删除的次数*/
+    unsigned long long parse_ns, print_ns, delete_ns; /*各阶段的耗时，纳秒；并行解析时是各线程加起来的*/
+}cjson_Stats;
+
+/*
+  解析/输出/创建的上下文：内存钩子、限制和错误信息都在这里，
+  每个线程用自己的上下文，互相之间没有共享的可变状态。
+  旧接口使用一个内部的默认上下文（cjson_InitHooks修改它，不限制深度）。
+*/
+typedef struct cjson_Context
+{
+    cjson_Hooks hooks; /*本上下文的malloc和free*/
+    cjson_Arena *arena; /*不为空时节点和字符串分配在arena中*/
+    int options; /*cjson_Option_*的组合*/
+    int max_depth; /*解析的最大嵌套深度，0表示不限制（所有接口都不递归，只受内存限制）*/
+    const char *error_ptr; /*最近一次解析出错的位置*/
+    int error; /*最近一次的错误码*/
+    cjson_Stats *stats; /*不为空时记录统计，见CJSON_STATS*/
+    cjson_Pool *pool; /*不为空且没有arena时节点从节点池中分配*/
+}cjson_Context;
+/*初始化上下文，hooks为空时使用malloc和free*/
+extern void cjson_InitContext(cjson_Context *ctx, cjson_Hooks *hooks);
+/*编译时是否打开了统计*/
+extern int cjson_StatsEnabled(void);
+/*给旧接口用的默认上下文挂上统计（会清零），stats为空时不再统计*/
+extern void cjson_InitStats(cjson_Stats *stats);
+/*复制一份当前的统计到out，上下文没有挂统计时全是0*/
+extern void cjson_GetStats(cjson_Stats *out);
+extern void cjson_GetStatsWithContext(cjson_Context *ctx, cjson_Stats *out);
+/*统计清零*/
+extern void cjson_ResetStats(void);
+extern void cjson_ResetStatsWithContext(cjson_Context *ctx);
+
+/*
+  arena分配器：按块向cjson_malloc申请内存，块内顺序分配。
+  一次解析的所有节点和字符串都放在arena中，用cjson_ArenaReset一次性释放整棵树，
+  块会留下来给下一次解析复用。arena中的节点不要再单独释放它的键名和字符串值，
+  给它们设置键名请用cjson_AddItemToObjectCS，或者用带这个arena的上下文调用cjson_AddItemToObjectWithContext。
+*/
+/*chunk_size为每块的大小，传0使用默认大小*/
+extern cjson_Arena *cjson_ArenaCreate(size_t chunk_size);
+extern cjson_Arena *cjson_ArenaCreateWithContext(cjson_Context *ctx, size_t chunk_size);
+extern void cjson_ArenaReset(cjson_Arena *arena);
+extern void cjson_ArenaDestroy(cjson_Arena *arena);
+
+/*
+  节点池：cjson节点大小固定，按块申请，每块slab_nodes个节点（传0使用默认值），
+  删除的节点放回空闲链表给下一个节点用，长时间运行时请求之间复用节点的内存，不会把堆弄碎。
+  把池挂到上下文的pool上（旧接口用cjson_InitPool），解析、cjson_Create*和cjson_Duplicate的节点都从池里取，
+  cjson_Delete放回池里；键名和字符串仍然用钩子分配。池里的节点要用挂着同一个池的上下文删除，
+  上下文没挂池时节点留在池里等cjson_PoolDestroy一起释放。cjson_PoolDestroy之后池里来的节点都不能再用。
+  一个池默认只给一个线程用；flags带cjson_Pool_Shared时可以多个线程共用（并行解析、后台删除），
+  每个线程先在自己的缓存里取放节点，缓存空了或满了才加锁和池交换一批，线程退出时缓存的节点还给池
+*/
+#define cjson_Pool_Shared 1
+extern cjson_Pool *cjson_PoolCreate(size_t slab_nodes, int flags);
+extern cjson_Pool *cjson_PoolCreateWithContext(cjson_Context *ctx, size_t slab_nodes, int flags);
+extern void cjson_PoolDestroy(cjson_Pool *pool);
+/*给旧接口用的默认上下文挂上节点池，pool为空时不再用池*/
+extern void cjson_InitPool(cjson_Pool *pool);
+
 /*提供一个json模块，会返回查询的json对象，完成后调用cjson_delete函数*/
 extern cjson *cjson_Parse(const char *value);
 /*提供json实例转换为传输/存储文本完成释放char**/
@@ -48,16 +157,60 @@ extern char  *cjson_Print(cjson *item);
 extern char  *cjson_PrintUnformatted(cjson *item);
 /*提供json实例前置缓冲和文本是否格式化，利用缓冲减少重新分配*/
 extern char  *cjson_PrintBuffered(cjson *item, int prebuffer, int fmt);
-/*删除一个json实例和所以子集*/
+/*
+  流式输出：格式和cjson_Print一样，但不拼出整个字符串，而是用buffer攒一段就交给write写出去，
+  内存占用只有buffer（至少64字节）。write返回0表示写失败，输出随即停止。成功返回1，失败返回0
+*/
+typedef int (*cjson_WriteFn)(void *user, const char *data, size_t len);
+extern int    cjson_PrintToWriter(cjson *item, int fmt, cjson_WriteFn write, void *user, char *buffer, size_t buffer_size);
+/*流式输出到文件，用栈上4KB的缓冲*/
+extern int    cjson_PrintToFile(cjson *item, int fmt, FILE *fp);
+/*删除一个json实例和所以子集，不递归也不分配内存，多深的树都可以*/
 extern void   cjson_Delete(cjson *c);
+/*
+  后台删除：cjson_ReclaimerCreate启动一个线程，cjson_DeleteLater把树交给它就返回，
+  释放的时间不算在调用者头上。钩子的free必须是线程安全的，交出去的树调用者不能再碰；
+  arena中的树直接用cjson_ArenaReset，不要交给它。没有pthread或者线程起不来时cjson_DeleteLater当场删除。
+  cjson_ReclaimerDestroy等交出去的树都删完再返回
+*/
+typedef struct cjson_Reclaimer cjson_Reclaimer;
+extern cjson_Reclaimer *cjson_ReclaimerCreate(void);
+extern void   cjson_DeleteLater(cjson_Reclaimer *r, cjson *c);
+extern void   cjson_ReclaimerDestroy(cjson_Reclaimer *r);
 
-/*给出json实例数组或对象中的项数*/
+/*给出json实例数组或对象中的项数，O(1)*/
 extern int    cjson_GetArraySize(cjson *array);
 
-/*从项数组中利用编号索引项, 如果没有就返回空*/
+/*
+  从项数组中利用编号索引项, 如果没有就返回空
+  有下标索引时是O(1)的，否则顺序走。索引见cjson_BuildIndex
+*/
 extern cjson *cjson_GetArrayItem(cjson *array, int item);
-/*部分大小写利用项名获取项*/
+/*
+  部分大小写利用项名获取项
+  有键名索引时不用顺序查找。查找不修改树，多个线程可以同时查。直接改子项的string会让索引失效
+*/
 extern cjson *cjson_GetObjectItem(cjson *object, const char *string);
+/*区分大小写（JSON规定的语义）利用项名获取项，比cjson_GetObjectItem快*/
+extern cjson *cjson_GetObjectItemCaseSensitive(cjson *object, const char *string);
+/*
+  给item和它下面子项达到CJSON_INDEX_THRESHOLD的对象和数组建立索引（修改了树，不要和查找同时做），
+  之后的cjson_GetObjectItem和cjson_GetArrayItem不用顺序走。解析出来的树也可以用cjson_Option_IndexObjects
+  和cjson_Option_IndexArrays在解析时建好。arena中的树要用带同一个arena的上下文。内存不够时返回0，
+  已经建好的索引照常使用
+*/
+extern int    cjson_BuildIndex(cjson *item);
+extern int    cjson_BuildIndexWithContext(cjson_Context *ctx, cjson *item);
+/*
+  取字符串值和数字值，类型不对时返回0。用cjson_Option_Lazy解析的树必须用这几个函数取值：
+  惰性的值记录的是原文在输入中的位置（所以输入要比树活得久），第一次取值时才转换并存到节点上，
+  之后和普通节点一样。字符串用ctx的钩子分配（arena中的节点要用带同一个arena的上下文）；
+  取值会改动节点，多个线程同时读同一棵惰性树时要自己加锁。输出、复制和cjson_DocFromTree不需要先取值
+*/
+extern const char *cjson_GetStringValue(cjson *item);
+extern const char *cjson_GetStringValueWithContext(cjson_Context *ctx, cjson *item);
+extern double cjson_GetNumberValue(cjson *item);
+extern long long cjson_GetInt64Value(cjson *item);
 
 /*当cjson_Parse返回0时表示parse错误，它就是成功，所以定义在cjson_Parse返回0时，解析指向错误的指针*/
 extern const char *cjson_GetErrorPtr(void);
@@ -85,7 +238,7 @@ extern void cjson_AddItemToArray(cjson *array, cjson *item);
 extern void cjson_AddItemToObject(cjson *object, const char *string, cjson *item);
 extern void cjson_AddItemToObjectCS(cjson *array, const char *string, cjson *item);
 
-/*将对项的引用添加*/
+/*将对项的引用添加，惰性的值先用cjson_GetStringValue转换（arena中的惰性字符串要先用带arena的上下文取值，否则不添加）*/
 extern void cjson_AddItemReferenceToArray(cjson *array, cjson *item);
 extern void cjson_AddItemReferenceToObject(cjson *array, const char *string, cjson *item);
 /*从数组或者对象中，删除项*/
@@ -93,12 +246,15 @@ extern cjson *cjson_DetachItemFromArray(cjson *array, int which);
 extern void   cjson_DeleteItemFromArray(cjson *array, int which);
 extern cjson *cjson_DetachItemFromObject(cjson *object, const char *string);
 extern void   cjson_DeleteItemFromObject(cjson *object, const char *string);
+extern cjson *cjson_DetachItemFromObjectCaseSensitive(cjson *object, const char *string);
+extern void   cjson_DeleteItemFromObjectCaseSensitive(cjson *object, const char *string);
 
 /*更新项*/
 /*将已存在的项向右移动*/
 extern void cjson_InsertItemInArray(cjson *array, int which, cjson *newitem);
 extern void cjson_ReplaceItemInArray(cjson *array, int which, cjson *newitem);
 extern void cjson_ReplaceItemInObject(cjson *object, const char *string, cjson *newitem);
+extern void cjson_ReplaceItemInObjectCaseSensitive(cjson *object, const char *string, cjson *newitem);
 
 /*复制一个cjson项*/
 extern cjson *cjson_Duplicate(cjson *item, int recurse); 
@@ -106,6 +262,152 @@ extern cjson *cjson_Duplicate(cjson *item, int recurse);
 /*检索是否以null结尾，并返回一个指向终点的指针*/
 extern cjson *cjson_ParseWithOpts(const char *value, const char **return_parse_end, int require_null_terminated);
 
+/*
+  只解析value开始的buffer_length个字节，不需要'\0'结尾，也不会读到buffer_length之外，
+  可以直接解析网络接收缓冲或mmap的内存。require_null_terminated表示值后面只能有空白（或'\0'）
+*/
+extern cjson *cjson_ParseWithLength(const char *value, size_t buffer_length);
+extern cjson *cjson_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, int require_null_terminated);
+
+/*
+  带上下文的接口，和上面对应的接口行为相同，只是内存从ctx中分配，错误记录在ctx->error_ptr和ctx->error。
+  用某个上下文创建的树要用同一个上下文删除，输出的字符串用ctx->hooks.free_fn释放。
+*/
+extern cjson *cjson_ParseWithContext(cjson_Context *ctx, const char *value, const char **return_parse_end, int require_null_terminated);
+extern cjson *cjson_ParseWithLengthContext(cjson_Context *ctx, const char *value, size_t buffer_length, const char **return_parse_end, int require_null_terminated);
+extern char  *cjson_PrintWithContext(cjson_Context *ctx, cjson *item, int fmt);
+extern char  *cjson_PrintBufferedWithContext(cjson_Context *ctx, cjson *item, int prebuffer, int fmt);
+extern int    cjson_PrintToWriterWithContext(cjson_Context *ctx, cjson *item, int fmt, cjson_WriteFn write, void *user, char *buffer, size_t buffer_size);
+extern int    cjson_PrintToFileWithContext(cjson_Context *ctx, cjson *item, int fmt, FILE *fp);
+extern void   cjson_DeleteWithContext(cjson_Context *ctx, cjson *c);
+extern cjson_Reclaimer *cjson_ReclaimerCreateWithContext(cjson_Context *ctx);
+extern cjson *cjson_DuplicateWithContext(cjson_Context *ctx, cjson *item, int recurse);
+
+extern cjson *cjson_CreateNullWithContext(cjson_Context *ctx);
+extern cjson *cjson_CreateTrueWithContext(cjson_Context *ctx);
+extern cjson *cjson_CreateFalseWithContext(cjson_Context *ctx);
+extern cjson *cjson_CreateBoolWithContext(cjson_Context *ctx, int b);
+extern cjson *cjson_CreateNumberWithContext(cjson_Context *ctx, double num);
+extern cjson *cjson_CreateStringWithContext(cjson_Context *ctx, const char *string);
+extern cjson *cjson_CreateArrayWithContext(cjson_Context *ctx);
+extern cjson *cjson_CreateObjectWithContext(cjson_Context *ctx);
+
+extern void   cjson_AddItemToObjectWithContext(cjson_Context *ctx, cjson *object, const char *string, cjson *item);
+extern void   cjson_DeleteItemFromArrayWithContext(cjson_Context *ctx, cjson *array, int which);
+extern void   cjson_DeleteItemFromObjectWithContext(cjson_Context *ctx, cjson *object, const char *string);
+extern void   cjson_DeleteItemFromObjectCaseSensitiveWithContext(cjson_Context *ctx, cjson *object, const char *string);
+extern void   cjson_ReplaceItemInArrayWithContext(cjson_Context *ctx, cjson *array, int which, cjson *newitem);
+extern void   cjson_ReplaceItemInObjectWithContext(cjson_Context *ctx, cjson *object, const char *string, cjson *newitem);
+extern void   cjson_ReplaceItemInObjectCaseSensitiveWithContext(cjson_Context *ctx, cjson *object, const char *string, cjson *newitem);
+
+/*在arena中解析，返回的树不需要cjson_Delete，随cjson_ArenaReset/cjson_ArenaDestroy释放*/
+extern cjson *cjson_ParseWithArena(cjson_Arena *arena, const char *value);
+extern cjson *cjson_ParseWithArenaOpts(cjson_Arena *arena, const char *value, const char **return_parse_end, int require_null_terminated);
+
+/*
+  紧凑文档：只读的另一种表示，节点放在连续的池里，用编号互相引用，每个节点24字节，
+  短字符串直接放在节点里，大文档占的内存不到cjson树的一半，遍历时缓存命中也更好。
+  节点用cjson_DocRef编号访问，0表示没有；类型和cjson树的一样。整篇文档用cjson_DocDelete释放。
+  解析和转换都不递归，嵌套深度只受上下文的max_depth（默认上下文不限制）和内存限制。
+*/
+typedef struct cjson_Doc cjson_Doc;
+typedef unsigned cjson_DocRef;
+
+extern cjson_Doc *cjson_DocParse(const char *value);
+extern cjson_Doc *cjson_DocParseWithLengthContext(cjson_Context *ctx, const char *value, size_t buffer_length, const char **return_parse_end, int require_null_terminated);
+extern void       cjson_DocDelete(cjson_Doc *doc);
+/*和cjson树互相转换*/
+extern cjson_Doc *cjson_DocFromTree(cjson *item);
+extern cjson_Doc *cjson_DocFromTreeWithContext(cjson_Context *ctx, cjson *item);
+extern cjson     *cjson_DocToTree(cjson_Doc *doc, cjson_DocRef ref);
+extern cjson     *cjson_DocToTreeWithContext(cjson_Context *ctx, cjson_Doc *doc, cjson_DocRef ref);
+/*文档占用的字节数*/
+extern size_t     cjson_DocMemorySize(cjson_Doc *doc);
+
+extern cjson_DocRef cjson_DocRoot(cjson_Doc *doc);
+extern int          cjson_DocType(cjson_Doc *doc, cjson_DocRef ref);
+extern double       cjson_DocNumber(cjson_Doc *doc, cjson_DocRef ref);
+extern const char  *cjson_DocString(cjson_Doc *doc, cjson_DocRef ref);
+extern const char  *cjson_DocKey(cjson_Doc *doc, cjson_DocRef ref);
+extern int          cjson_DocSize(cjson_Doc *doc, cjson_DocRef ref);
+extern cjson_DocRef cjson_DocChild(cjson_Doc *doc, cjson_DocRef ref);
+extern cjson_DocRef cjson_DocNext(cjson_Doc *doc, cjson_DocRef ref);
+extern cjson_DocRef cjson_DocGetArrayItem(cjson_Doc *doc, cjson_DocRef ref, int item);
+extern cjson_DocRef cjson_DocGetObjectItem(cjson_Doc *doc, cjson_DocRef ref, const char *string);
+
+/*
+  推式解析器：文档分成任意大小的块依次交给cjson_PushParserFeed，块可以在字符串、数字、转义序列的中间切开，
+  只有被切开的那个值需要暂存，不用先把整篇文档攒起来。全部喂完后cjson_PushParserFinish返回整棵树，
+  和cjson_ParseWithOpts(value, 0, 1)解析整篇文档的结果一样，由调用者用cjson_Delete释放。
+  Feed返回cjson_Error_*，出错后之后的Feed都返回同一个错误；错误也记录在上下文中，
+  error_ptr指向出错的那一块里（或解析器内部的暂存区），文档不完整时为0。
+  解析器用完后用cjson_PushParserDestroy释放（包括没有取走的半棵树）
+*/
+typedef struct cjson_PushParser cjson_PushParser;
+extern cjson_PushParser *cjson_PushParserCreate(void);
+extern cjson_PushParser *cjson_PushParserCreateWithContext(cjson_Context *ctx);
+extern int    cjson_PushParserFeed(cjson_PushParser *pp, const char *data, size_t len);
+extern cjson *cjson_PushParserFinish(cjson_PushParser *pp);
+extern void   cjson_PushParserDestroy(cjson_PushParser *pp);
+
+/*
+  SAX式解析：按和cjson_Parse一样的语法走一遍文档，每遇到一个值就调用对应的回调，不建立任何节点。
+  键名和字符串以(指针, 长度)给出，不以'\0'结尾：没有转义时直接指向输入，有转义时指向解析器内部的暂存区，
+  只在回调期间有效。数字同时给出double和截断后的64位整数。回调可以为空（忽略这种事件），
+  返回0则停止解析，返回cjson_Error_Stopped。根后面只能有空白。
+  不递归，嵌套深度只受上下文的max_depth（默认上下文不限制）和内存限制
+*/
+typedef struct cjson_SaxHandler
+{
+    int (*start_object)(void *user);
+    int (*end_object)(void *user);
+    int (*start_array)(void *user);
+    int (*end_array)(void *user);
+    int (*key)(void *user, const char *str, size_t len);
+    int (*string)(void *user, const char *str, size_t len);
+    int (*number)(void *user, double d, long long i);
+    int (*boolean)(void *user, int b);
+    int (*null)(void *user);
+}cjson_SaxHandler;
+/*返回cjson_Error_*，出错位置和错误码也记录在上下文中*/
+extern int    cjson_SaxParse(const char *value, size_t buffer_length, const cjson_SaxHandler *handler, void *user);
+extern int    cjson_SaxParseWithContext(cjson_Context *ctx, const char *value, size_t buffer_length, const cjson_SaxHandler *handler, void *user);
+
+/*
+  批量解析：NDJSON（每行一篇）或者首尾相接的多篇文档。cjson_BatchNext每次解析一篇，
+  没有更多文档时返回0；否则返回1，*doc是这一篇的树，解析出错时为0，错误码用cjson_BatchError取，
+  出错的字节偏移用cjson_BatchErrorOffset取，出错后从这一篇开头之后的下一行继续，不影响后面的文档。
+  树放在批量解析器自己的arena里，下一次Next时就失效了，不要cjson_Delete，要留下来请cjson_Duplicate；
+  arena在文档之间反复使用，稳定下来后每篇文档不再申请内存。
+  缓冲模式直接解析调用者的data（解析完之前不能释放）；流模式从read读，每行必须正好是一篇文档
+*/
+typedef struct cjson_Batch cjson_Batch;
+/*从流中读最多len字节到data，返回读到的字节数，0表示结束*/
+typedef size_t (*cjson_ReadFn)(void *user, char *data, size_t len);
+extern cjson_Batch *cjson_BatchCreate(const char *data, size_t len);
+extern cjson_Batch *cjson_BatchCreateWithContext(cjson_Context *ctx, const char *data, size_t len);
+extern cjson_Batch *cjson_BatchCreateWithReader(cjson_Context *ctx, cjson_ReadFn read, void *user);
+extern cjson_Batch *cjson_BatchCreateFromFile(FILE *fp);
+extern int    cjson_BatchNext(cjson_Batch *batch, cjson **doc);
+extern size_t cjson_BatchOffset(cjson_Batch *batch);
+extern int    cjson_BatchError(cjson_Batch *batch);
+extern size_t cjson_BatchErrorOffset(cjson_Batch *batch);
+extern void   cjson_BatchDestroy(cjson_Batch *batch);
+
+/*
+  并行解析，threads为线程数，0表示CPU的个数（每个线程至少分到64KB，输入小时线程会少一些）。
+  cjson_ParseParallel：根是数组时把元素分给几个线程解析，结果和cjson_ParseWithLengthOpts(value, buffer_length, 0, 1)一样，
+  出错时改用串行解析，报告的错误也一样。
+  cjson_ParseLinesParallel：NDJSON按行分给几个线程，每行一篇（空行跳过），按原来的顺序放在返回的数组里；
+  有一行出错就返回0，错误记录的是最前面出错的那一行。
+  上下文带arena时每个线程用自己的arena，解析完并进上下文的arena。钩子必须是线程安全的；
+  需要pthread，编译时定义CJSON_NO_THREADS则在当前线程上依次解析
+*/
+extern cjson *cjson_ParseParallel(const char *value, size_t buffer_length, int threads);
+extern cjson *cjson_ParseParallelWithContext(cjson_Context *ctx, const char *value, size_t buffer_length, int threads);
+extern cjson *cjson_ParseLinesParallel(const char *value, size_t buffer_length, int threads);
+extern cjson *cjson_ParseLinesParallelWithContext(cjson_Context *ctx, const char *value, size_t buffer_length, int threads);
+
 extern void cjson_Minify(char *json);
 
 /* 快速创建内容的宏*/
@@ -118,8 +420,9 @@ extern void cjson_Minify(char *json);
 #define cjson_AddStringToObject(object, name, s)  cjson_AddItemToObject(object, name, cjson_CreateString(s))
 
 /*分配int值和double值相互传达*/
-#define cjson_SetIntValue(object, val)    ((object)?(object)->valueint=(object)->valuedouble=(val):(val))
-#define cjson_SetNumberValue(object, val) ((object)?(object)->valueint=(object)->valuedouble=(val):(val))
+extern double cjson_SetNumberHelper(cjson *object, double number);
+#define cjson_SetIntValue(object, val)    ((object)?cjson_SetNumberHelper(object, (double)(val)):(val))
+#define cjson_SetNumberValue(object, val) ((object)?cjson_SetNumberHelper(object, (double)(val)):(val))
 
 #ifdef __cplusplus
 }
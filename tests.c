@@ -0,0 +1,1113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#ifndef CJSON_NO_THREADS
+#include <pthread.h>
+#endif
+#include "cjson.h"
+
+/*
+  回归测试：每一项检查不通过时打印所在的行，最后报告检查了多少项、失败了多少项，
+  有失败时返回1。make test编译并运行。
+*/
+
+static int checks, failures;
+static void check(int ok, const char *what, int line) {
+  ++checks;
+  if (ok) return;
+  ++failures;
+  printf("tests.c:%d: check failed: %s\n", line, what);
+}
+#define CHECK(cond) check((cond) != 0, #cond, __LINE__)
+
+/*可以追加的字符串缓冲*/
+typedef struct
+{
+  char *buf;
+  size_t len, cap;
+} text;
+
+static void text_append(text *t, const char *s, size_t n) {
+  if (t->len + n + 1 > t->cap) {
+    t->cap = (t->len + n + 1) * 2;
+    t->buf = (char *)realloc(t->buf, t->cap);
+  }
+  memcpy(t->buf + t->len, s, n);
+  t->len += n;
+  t->buf[t->len] = 0;
+}
+static void text_add(text *t, const char *s) {text_append(t, s, strlen(s));}
+
+/*固定种子的xorshift，每次生成的文档一样*/
+static unsigned long long seed = 88172645463325252ULL;
+static unsigned next_rand(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return (unsigned)(seed >> 32);
+}
+
+/*生成一个随机的值，depth控制还能嵌套几层*/
+static void random_value(text *t, int depth) {
+  char buf[64];
+  int i, n;
+  switch (next_rand() % (depth > 0 ? 8 : 6)) {
+  case 0: text_add(t, "null"); break;
+  case 1: text_add(t, next_rand() & 1 ? "true" : "false"); break;
+  case 2: sprintf(buf, "%d", (int)(next_rand() % 2000000) - 1000000); text_add(t, buf); break;
+  case 3: sprintf(buf, "%.17g", (double)next_rand() / 4096.0 - 500000.0); text_add(t, buf); break;
+  case 4: sprintf(buf, "\"s%u\"", next_rand() % 1000); text_add(t, buf); break;
+  case 5: text_add(t, "\"esc\\\"\\n\\u00e9\\ud83d\\ude00\""); break;
+  case 6:
+    text_add(t, "[");
+    for (i = 0, n = next_rand() % 6; i < n; ++i) {
+      if (i) text_add(t, ",");
+      random_value(t, depth - 1);
+    }
+    text_add(t, "]");
+    break;
+  default:
+    text_add(t, "{");
+    for (i = 0, n = next_rand() % 6; i < n; ++i) {
+      sprintf(buf, "%s\"k%d\":", i ? "," : "", i);
+      text_add(t, buf);
+      random_value(t, depth - 1);
+    }
+    text_add(t, "}");
+    break;
+  }
+}
+
+/*比较两棵树输出的文本是否一样*/
+static int same_tree(cjson *a, cjson *b) {
+  char *x, *y;
+  int same;
+  if (!a || !b) return a == b;
+  x = cjson_PrintUnformatted(a);
+  y = cjson_PrintUnformatted(b);
+  same = x && y && !strcmp(x, y);
+  free(x);
+  free(y);
+  return same;
+}
+
+/*解析一个数字，和strtod的结果逐位比较；int64不为空时还要求整数值等于*int64*/
+static void check_number(const char *num, const long long *int64, int line) {
+  cjson *item = cjson_ParseWithLength(num, strlen(num));
+  double expect = strtod(num, 0);
+  int ok = item && item->type == cjson_Number && !memcmp(&item->valuedouble, &expect, sizeof(double));
+  if (ok && int64) ok = item->valueint64 == *int64;
+  check(ok, num, line);
+  cjson_Delete(item);
+}
+#define CHECK_NUMBER(num) check_number(num, 0, __LINE__)
+#define CHECK_INT64(num, i) do {long long expect_ = (i); check_number(num, &expect_, __LINE__);} while (0)
+
+/*start乘times次factor得到的整数的十进制数字，out至少要放得下结果和'\0'*/
+static char *big_digits(unsigned long long start, int factor, int times, char *out) {
+  unsigned char d[1200];
+  int n = 0, i, carry;
+  for (; start; start /= 10) d[n++] = (unsigned char)(start % 10);
+  while (times--) {
+    for (carry = i = 0; i < n; ++i) {
+      carry += d[i] * factor;
+      d[i] = (unsigned char)(carry % 10);
+      carry /= 10;
+    }
+    for (; carry; carry /= 10) d[n++] = (unsigned char)(carry % 10);
+  }
+  for (i = 0; i < n; ++i) out[i] = (char)('0' + d[n - 1 - i]);
+  out[n] = 0;
+  return out;
+}
+
+/*
+  超过SLOW_DIGITS位有效数字的尾数：两个double正中间的数（2^-1075 = 5^1075e-1075、
+  DBL_MAX和2^1024的中点 = (2^54-1)*2^970），以及在中点后面很远处多一点、少一点的数
+*/
+static void test_long_mantissa(void) {
+  static const double expect[2][3] = {{0, 4.9406564584124654e-324, 0}, {HUGE_VAL, HUGE_VAL, DBL_MAX}};
+  char digits[1200], num[2000];
+  cjson *item;
+  int i, k, n;
+  for (i = 0; i < 2; ++i) {
+    if (i == 0) big_digits(1, 5, 1075, digits);
+    else big_digits((1ULL << 54) - 1, 2, 970, digits);
+    for (k = 0; k < 3; ++k) {/*中点、后面一点、前面一点*/
+      n = sprintf(num, "%s.", digits);
+      if (k == 1) {
+        memset(num + n, '0', 300);
+        n += 300;
+        num[n++] = '1';
+      }
+      if (k == 2) {
+        --num[n - 2];
+        memset(num + n, '9', 300);
+        n += 300;
+      }
+      num[n++] = '0';
+      sprintf(num + n, "%s", i == 0 ? "e-1075" : "");
+      CHECK_NUMBER(num);
+      item = cjson_Parse(num);
+      CHECK(item && item->valuedouble == expect[i][k]);
+      cjson_Delete(item);
+    }
+  }
+  /*随机的长尾数，有效数字从几百到一千多位*/
+  for (i = 0; i < 300; ++i) {
+    n = 0;
+    if (next_rand() & 1) num[n++] = '-';
+    num[n++] = (char)('1' + next_rand() % 9);
+    for (k = 600 + next_rand() % 700; k; --k) {
+      if (k == 400 && (next_rand() & 1)) num[n++] = '.';
+      num[n++] = (char)('0' + next_rand() % 10);
+    }
+    sprintf(num + n, "e%d", (int)(next_rand() % 1401) - 1000);
+    CHECK_NUMBER(num);
+  }
+}
+
+static void test_numbers(void) {
+  static const char *cases[] = {
+    /*长尾数：超过19位有效数字，丢掉的部分决定舍入方向*/
+    "1.00000000000000011102230246251565404236316680908203125",
+    "1.00000000000000011102230246251565404236316680908203124",
+    "1.000000000000000111022302462515654042363166809082031250001",
+    "123456789012345678901234567890",
+    "0.000000000000000000000000000000000000000001234567890123456789012345",
+    "179769313486231570814527423731704356798070567525844996598917476803157260780028538760589558632766878171540458953514382464234321326889464182768467546703537516986049910576551282076245490090389328944075868508455133942304583236903222948165808559332123348274797826204144723168738177180919299881250404026184124858368",
+    /*恰好在两个double中间，舍入到偶数*/
+    "9007199254740993", "9007199254740995", "-9007199254740993",
+    "9007199254740993.0", "9007199254740993e0", "90071992547409930e-1",
+    "2.2250738585072011e-308", "2.2250738585072012e-308",
+    /*次正规数*/
+    "4.9406564584124654e-324", "2.4703282292062328e-324", "2.4703282292062327e-324",
+    "2.2250738585072009e-308", "1e-310", "-1e-320", "5e-324", "3e-324",
+    /*指数的两端*/
+    "1e308", "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308",
+    "1e309", "-1e400", "1e-400", "-1e-400", "1e-324", "0e999999999", "1e-99999999999",
+    "1e99999999999", "0.0", "-0.0", "-0", "0e-5",
+    /*一般的数*/
+    "0.1", "0.2", "0.3", "3.14159265358979323846", "1e23", "8.41e21", "5e-20", "12345.6789e-3",
+  };
+  char buf[128];
+  double d;
+  int i, j, n;
+  for (i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); ++i) CHECK_NUMBER(cases[i]);
+
+  /*±2^63附近：64位范围内的整数是精确的，超出时取最大或最小值*/
+  CHECK_INT64("9223372036854775807", LLONG_MAX);
+  CHECK_INT64("9223372036854775808", LLONG_MAX);
+  CHECK_INT64("18446744073709551616", LLONG_MAX);
+  CHECK_INT64("-9223372036854775807", -LLONG_MAX);
+  CHECK_INT64("-9223372036854775808", LLONG_MIN);
+  CHECK_INT64("-9223372036854775809", LLONG_MIN);
+  CHECK_INT64("9007199254740993", 9007199254740993LL);
+  CHECK_INT64("-0", 0);
+  CHECK_INT64("1e3", 1000);
+  CHECK_INT64("9.2233720368547758e18", LLONG_MAX);
+
+  /*随机的数字：整数部分、小数部分都是0到25位，指数在-350到350之间*/
+  for (i = 0; i < 20000; ++i) {
+    n = 0;
+    if (next_rand() & 1) buf[n++] = '-';
+    j = next_rand() % 26;
+    if (!j) buf[n++] = '0';
+    else {
+      buf[n++] = (char)('1' + next_rand() % 9);
+      while (--j) buf[n++] = (char)('0' + next_rand() % 10);
+    }
+    if (next_rand() & 1) {
+      buf[n++] = '.';
+      j = 1 + next_rand() % 25;
+      while (j--) buf[n++] = (char)('0' + next_rand() % 10);
+    }
+    if (next_rand() & 1) n += sprintf(buf + n, "e%d", (int)(next_rand() % 701) - 350);
+    buf[n] = 0;
+    CHECK_NUMBER(buf);
+  }
+  /*随机的double用%.17g输出再解析，必须回到同一个值*/
+  for (i = 0; i < 20000; ++i) {
+    unsigned long long bits = ((unsigned long long)next_rand() << 32) | next_rand();
+    memcpy(&d, &bits, sizeof(d));
+    if (d != d || d - d != 0) continue;/*跳过NaN和无穷大*/
+    sprintf(buf, "%.17g", d);
+    CHECK_NUMBER(buf);
+  }
+}
+
+/*输出一个数再解析回来，double和整数值都不变；out不为空时还要求输出的文本等于out*/
+static void check_print_number(cjson *item, const char *out, int line) {
+  char *text = cjson_PrintUnformatted(item);
+  cjson *back = text ? cjson_Parse(text) : 0;
+  int ok = back && !memcmp(&back->valuedouble, &item->valuedouble, sizeof(double)) && back->valueint64 == item->valueint64;
+  if (ok && out) ok = !strcmp(text, out);
+  check(ok, text ? text : "(null)", line);
+  cjson_Delete(back);
+  cjson_Delete(item);
+  free(text);
+}
+
+static void test_print_numbers(void) {
+  char buf[64];
+  double d;
+  int i;
+  /*2^63不能当成整数LLONG_MAX输出*/
+  check_print_number(cjson_Parse("9223372036854775808"), 0, __LINE__);
+  check_print_number(cjson_CreateNumber(9223372036854775808.0), 0, __LINE__);
+  check_print_number(cjson_CreateNumber(18446744073709551616.0), 0, __LINE__);
+  check_print_number(cjson_Parse("-9223372036854775808"), "-9223372036854775808", __LINE__);
+  check_print_number(cjson_Parse("9223372036854775807"), 0, __LINE__);
+  check_print_number(cjson_Parse("9007199254740993"), "9007199254740993", __LINE__);
+  check_print_number(cjson_Parse("-0"), "-0", __LINE__);
+  check_print_number(cjson_Parse("0.1"), "0.1", __LINE__);
+  check_print_number(cjson_Parse("1e300"), 0, __LINE__);
+  check_print_number(cjson_Parse("5e-324"), 0, __LINE__);
+  {
+    cjson *item = cjson_Parse("9223372036854775808");
+    char *text = cjson_PrintUnformatted(item);
+    CHECK(text && strcmp(text, "9223372036854775807"));
+    free(text);
+    cjson_Delete(item);
+  }
+  for (i = 0; i < 20000; ++i) {
+    unsigned long long bits = ((unsigned long long)next_rand() << 32) | next_rand();
+    memcpy(&d, &bits, sizeof(d));
+    if (d != d || d - d != 0) continue;
+    check_print_number(cjson_CreateNumber(d), 0, __LINE__);
+  }
+  for (i = 0; i < 2000; ++i) {/*64位范围内的整数原样输出*/
+    long long v = (long long)(((unsigned long long)next_rand() << 32) | next_rand()) >> (next_rand() % 64);
+    sprintf(buf, "%lld", v);
+    check_print_number(cjson_Parse(buf), buf, __LINE__);
+  }
+}
+
+/*按链表走到第which个子项*/
+static cjson *walk_item(cjson *c, int which) {
+  for (c = c->child; c && which--; c = c->next);
+  return c;
+}
+
+/*子链、count、最后一个子项的链接和索引互相一致*/
+static void check_container(cjson *c) {
+  cjson *it, *last = 0;
+  int n = 0;
+  for (it = c->child; it; it = it->next, ++n) {
+    if (it != c->child) CHECK(it->prev == last);
+    last = it;
+    if (c->type == cjson_Object) CHECK(cjson_GetObjectItemCaseSensitive(c, it->string) == it);
+    else CHECK(cjson_GetArrayItem(c, n) == it);
+  }
+  CHECK(cjson_GetArraySize(c) == n);
+  if (c->child) CHECK(c->child->prev == last);
+  if (c->type == cjson_Array) CHECK(cjson_GetArrayItem(c, n) == 0);
+}
+
+static void test_index(void) {
+  cjson *obj = cjson_CreateObject(), *arr = cjson_CreateArray(), *it;
+  cjson_Context ctx;
+  char key[16];
+  int i;
+  for (i = 0; i < 50; ++i) {
+    sprintf(key, "k%d", i);
+    cjson_AddItemToObject(obj, key, cjson_CreateNumber(i));
+    cjson_AddItemToArray(arr, cjson_CreateNumber(i));
+  }
+  /*查找不建索引，建索引要显式调用*/
+  CHECK(cjson_GetObjectItem(obj, "k40")->valueint == 40);
+  CHECK(cjson_GetArrayItem(arr, 40)->valueint == 40);
+  CHECK(!obj->index && !arr->index);
+  CHECK(cjson_BuildIndex(obj) && obj->index);
+  CHECK(cjson_BuildIndex(arr) && arr->index);
+  CHECK(cjson_GetObjectItem(obj, "k10")->valueint == 10);
+  CHECK(cjson_GetArrayItem(arr, 10)->valueint == 10);
+  check_container(obj);
+  check_container(arr);
+
+  /*摘掉头、中间和尾，替换、再添加*/
+  cjson_Delete(cjson_DetachItemFromObject(obj, "k0"));
+  cjson_Delete(cjson_DetachItemFromObjectCaseSensitive(obj, "k25"));
+  cjson_DeleteItemFromObject(obj, "k49");
+  cjson_ReplaceItemInObject(obj, "k5", cjson_CreateNumber(500));
+  cjson_ReplaceItemInObjectCaseSensitive(obj, "k1", cjson_CreateNumber(100));
+  cjson_AddItemToObject(obj, "new", cjson_CreateNull());
+  CHECK(cjson_GetObjectItem(obj, "k0") == 0);
+  CHECK(cjson_GetObjectItem(obj, "k25") == 0);
+  CHECK(cjson_GetObjectItem(obj, "k49") == 0);
+  CHECK(cjson_GetObjectItem(obj, "K5")->valueint == 500);
+  CHECK(cjson_GetObjectItemCaseSensitive(obj, "K5") == 0);
+  CHECK(cjson_GetObjectItemCaseSensitive(obj, "k1")->valueint == 100);
+  CHECK(cjson_GetObjectItem(obj, "new")->type == cjson_Null);
+  CHECK(cjson_GetArraySize(obj) == 48);
+  check_container(obj);
+
+  it = cjson_DetachItemFromArray(arr, 0);
+  CHECK(it && it->valueint == 0 && !it->next && !it->prev);
+  cjson_Delete(it);
+  cjson_InsertItemInArray(arr, 5, cjson_CreateNumber(-5));
+  cjson_InsertItemInArray(arr, 0, cjson_CreateNumber(-1));
+  cjson_ReplaceItemInArray(arr, 7, cjson_CreateNumber(-7));
+  cjson_DeleteItemFromArray(arr, 20);
+  cjson_DeleteItemFromArray(arr, cjson_GetArraySize(arr) - 1);
+  cjson_AddItemToArray(arr, cjson_CreateNumber(1000));
+  CHECK(cjson_GetArraySize(arr) == 50);
+  CHECK(cjson_GetArrayItem(arr, 0)->valueint == -1);
+  CHECK(cjson_GetArrayItem(arr, 6)->valueint == -5);
+  CHECK(cjson_GetArrayItem(arr, 7)->valueint == -7);
+  CHECK(cjson_GetArrayItem(arr, 49)->valueint == 1000);
+  for (i = 0; i < 50; ++i) CHECK(cjson_GetArrayItem(arr, i) == walk_item(arr, i));
+  check_container(arr);
+
+  /*把数组删到只剩一项再加回来*/
+  while (cjson_GetArraySize(arr) > 1) cjson_DeleteItemFromArray(arr, 1);
+  cjson_AddItemToArray(arr, cjson_CreateNumber(2));
+  CHECK(cjson_GetArrayItem(arr, 1)->valueint == 2);
+  check_container(arr);
+  cjson_Delete(obj);
+  cjson_Delete(arr);
+
+  /*在大数组里按名字找：数组的下标索引不能当哈希用，也不能在数组上建哈希索引*/
+  arr = cjson_CreateArray();
+  for (i = 0; i < 40; ++i) cjson_AddItemToArray(arr, cjson_CreateNumber(i));
+  CHECK(cjson_GetObjectItem(arr, "k1") == 0);
+  CHECK(cjson_GetObjectItemCaseSensitive(arr, "k1") == 0);
+  CHECK(cjson_BuildIndex(arr) && arr->index);
+  CHECK(cjson_GetArrayItem(arr, 30)->valueint == 30);
+  CHECK(cjson_GetObjectItem(arr, "k1") == 0);
+  CHECK(cjson_GetObjectItemCaseSensitive(arr, "k1") == 0);
+  CHECK(cjson_GetArrayItem(arr, 39)->valueint == 39);
+  check_container(arr);
+  cjson_Delete(arr);
+  cjson_InitContext(&ctx, 0);
+  ctx.options = cjson_Option_IndexObjects | cjson_Option_IndexArrays;
+  arr = cjson_ParseWithContext(&ctx, "[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19]", 0, 1);
+  CHECK(arr && arr->index);
+  if (arr) {
+    CHECK(cjson_GetObjectItem(arr, "a") == 0);
+    CHECK(cjson_GetObjectItemCaseSensitive(arr, "a") == 0);
+    CHECK(cjson_GetArrayItem(arr, 19)->valueint == 19);
+    check_container(arr);
+  }
+  cjson_Delete(arr);
+
+  /*cjson_BuildIndex给整棵树里的大容器建索引，小的不建*/
+  arr = cjson_CreateArray();
+  obj = cjson_CreateObject();
+  for (i = 0; i < 20; ++i) {
+    sprintf(key, "k%d", i);
+    cjson_AddItemToObject(obj, key, cjson_CreateNumber(i));
+  }
+  cjson_AddItemToArray(arr, cjson_CreateNull());
+  cjson_AddItemToArray(arr, obj);
+  CHECK(cjson_BuildIndex(arr));
+  CHECK(!arr->index && obj->index);
+  CHECK(cjson_GetObjectItemCaseSensitive(obj, "k19")->valueint == 19);
+  check_container(obj);
+  cjson_Delete(arr);
+}
+
+static int text_write(void *user, const char *data, size_t len) {
+  text_append((text *)user, data, len);
+  return 1;
+}
+static int fail_write(void *user, const char *data, size_t len) {
+  (void)user; (void)data; (void)len;
+  return 0;
+}
+
+static void test_stream_print(void) {
+  char buffer[64];
+  char *out;
+  int i, fmt;
+  text doc = {0};
+  cjson *root;
+  for (i = 0; i < 200; ++i) {
+    doc.len = 0;
+    random_value(&doc, 5);
+    root = cjson_Parse(doc.buf);
+    CHECK(root != 0);
+    if (!root) continue;
+    for (fmt = 0; fmt < 2; ++fmt) {
+      text streamed = {0};
+      out = fmt ? cjson_Print(root) : cjson_PrintUnformatted(root);
+      CHECK(cjson_PrintToWriter(root, fmt, text_write, &streamed, buffer, sizeof(buffer)));
+      CHECK(streamed.buf && !strcmp(streamed.buf, out));
+      free(out);
+      free(streamed.buf);
+    }
+    CHECK(!cjson_PrintToWriter(root, 0, fail_write, 0, buffer, sizeof(buffer)));
+    cjson_Delete(root);
+  }
+  free(doc.buf);
+}
+
+/*统计通过钩子申请内存的次数*/
+static int hook_allocs;
+static void *count_malloc(size_t sz) {
+  ++hook_allocs;
+  return malloc(sz);
+}
+
+/*带上下文的流式输出：遍历深树用的栈从这个上下文的钩子分配*/
+static void test_stream_print_context(void) {
+  cjson_Hooks hooks = {count_malloc, free};
+  cjson_Context ctx;
+  char buffer[64], file_out[4096];
+  text streamed = {0};
+  char *out;
+  cjson *root = cjson_CreateArray(), *c = root;
+  FILE *fp;
+  size_t n;
+  int i;
+  for (i = 0; i < 100; ++i) {
+    cjson *inner = cjson_CreateArray();
+    cjson_AddItemToArray(c, cjson_CreateNumber(i));
+    cjson_AddItemToArray(c, inner);
+    c = inner;
+  }
+  cjson_InitContext(&ctx, &hooks);
+  out = cjson_Print(root);
+  CHECK(cjson_PrintToWriterWithContext(&ctx, root, 1, text_write, &streamed, buffer, sizeof(buffer)));
+  CHECK(hook_allocs > 0);
+  CHECK(streamed.buf && !strcmp(streamed.buf, out));
+  if ((fp = tmpfile())) {
+    hook_allocs = 0;
+    CHECK(cjson_PrintToFileWithContext(&ctx, root, 1, fp));
+    CHECK(hook_allocs > 0);
+    rewind(fp);
+    n = fread(file_out, 1, sizeof(file_out) - 1, fp);
+    file_out[n] = 0;
+    CHECK(!strcmp(file_out, out));
+    fclose(fp);
+  }
+  free(out);
+  free(streamed.buf);
+  cjson_Delete(root);
+}
+
+/*SAX：用事件重新建一棵树，和cjson_Parse的结果比较*/
+typedef struct
+{
+  cjson *root, *stack[64];
+  int depth, events;
+  int stop_at;/*sax_counter在第几个事件停下，0表示不停*/
+  char key[64];
+} sax_builder;
+
+static void sax_add(sax_builder *b, cjson *item) {
+  cjson *parent = b->depth ? b->stack[b->depth - 1] : 0;
+  ++b->events;
+  if (!parent) b->root = item;
+  else if (parent->type == cjson_Object) cjson_AddItemToObject(parent, b->key, item);
+  else cjson_AddItemToArray(parent, item);
+  if (item->type == cjson_Array || item->type == cjson_Object) b->stack[b->depth++] = item;
+}
+static int sax_start_object(void *user) {sax_add((sax_builder *)user, cjson_CreateObject()); return 1;}
+static int sax_start_array(void *user) {sax_add((sax_builder *)user, cjson_CreateArray()); return 1;}
+static int sax_end(void *user) {--((sax_builder *)user)->depth; return 1;}
+static int sax_key(void *user, const char *str, size_t len) {
+  sax_builder *b = (sax_builder *)user;
+  if (len >= sizeof(b->key)) return 0;
+  memcpy(b->key, str, len);
+  b->key[len] = 0;
+  return 1;
+}
+static int sax_string(void *user, const char *str, size_t len) {
+  char *copy = (char *)malloc(len + 1);
+  memcpy(copy, str, len);
+  copy[len] = 0;
+  sax_add((sax_builder *)user, cjson_CreateString(copy));
+  free(copy);
+  return 1;
+}
+static int sax_number(void *user, double d, long long i) {(void)i; sax_add((sax_builder *)user, cjson_CreateNumber(d)); return 1;}
+static int sax_boolean(void *user, int b) {sax_add((sax_builder *)user, cjson_CreateBool(b)); return 1;}
+static int sax_null(void *user) {sax_add((sax_builder *)user, cjson_CreateNull()); return 1;}
+static const cjson_SaxHandler sax_build = {
+  sax_start_object, sax_end, sax_start_array, sax_end, sax_key, sax_string, sax_number, sax_boolean, sax_null
+};
+/*只数事件，第stop_at个事件返回0*/
+static int sax_count(void *user) {
+  sax_builder *b = (sax_builder *)user;
+  return ++b->events != b->stop_at;
+}
+static const cjson_SaxHandler sax_counter = {sax_count, sax_count, sax_count, sax_count, 0, 0, 0, 0, 0};
+
+/*很深的[[[...]]]，n层*/
+static char *deep_arrays(size_t n, int closed) {
+  char *s = (char *)malloc(2 * n + 1);
+  memset(s, '[', n);
+  memset(s + n, ']', closed ? n : 0);
+  s[closed ? 2 * n : n] = 0;
+  return s;
+}
+
+static void test_sax(void) {
+  static const char *bad[] = {"[1,]", "{\"a\" 1}", "{\"a\":}", "[1 2]", "{,}", "[", "{\"a\":1,}", "[]]", "nul", "[1] x", "{1:2}", ""};
+  cjson_Context ctx, parse_ctx;
+  sax_builder b;
+  text doc = {0};
+  cjson *root;
+  char *deep;
+  int i;
+  for (i = 0; i < 200; ++i) {
+    doc.len = 0;
+    random_value(&doc, 5);
+    memset(&b, 0, sizeof(b));
+    CHECK(cjson_SaxParse(doc.buf, doc.len, &sax_build, &b) == cjson_Error_None);
+    root = cjson_Parse(doc.buf);
+    CHECK(same_tree(root, b.root));
+    cjson_Delete(root);
+    cjson_Delete(b.root);
+  }
+  free(doc.buf);
+
+  /*出错的位置和cjson_ParseWithLengthContext一样*/
+  cjson_InitContext(&ctx, 0);
+  cjson_InitContext(&parse_ctx, 0);
+  for (i = 0; i < (int)(sizeof(bad) / sizeof(bad[0])); ++i) {
+    memset(&b, 0, sizeof(b));
+    CHECK(cjson_SaxParseWithContext(&ctx, bad[i], strlen(bad[i]), &sax_build, &b) == cjson_Error_Syntax);
+    CHECK(!cjson_ParseWithLengthContext(&parse_ctx, bad[i], strlen(bad[i]), 0, 1));
+    check(ctx.error_ptr == parse_ctx.error_ptr, bad[i], __LINE__);
+    cjson_Delete(b.root);
+  }
+
+  /*回调返回0时停在那里*/
+  memset(&b, 0, sizeof(b));
+  b.stop_at = 3;
+  CHECK(cjson_SaxParseWithContext(&ctx, "[[],[]]", 7, &sax_counter, &b) == cjson_Error_Stopped);
+  CHECK(b.events == 3 && ctx.error_ptr && *ctx.error_ptr == ']');
+
+  /*嵌套深度只受内存限制，默认上下文不限制；max_depth不为0时报cjson_Error_Depth*/
+  deep = deep_arrays(2000000, 1);
+  memset(&b, 0, sizeof(b));
+  CHECK(cjson_SaxParse(deep, 4000000, &sax_counter, &b) == cjson_Error_None);
+  CHECK(b.events == 4000000);
+  CHECK(cjson_SaxParseWithContext(&ctx, deep, 4000000, &sax_counter, &b) == cjson_Error_Depth);
+  CHECK(ctx.error_ptr == deep + CJSON_NESTING_LIMIT);
+  free(deep);
+  deep = deep_arrays(2000000, 0);
+  CHECK(cjson_SaxParse(deep, 2000000, &sax_counter, &b) == cjson_Error_Syntax);
+  free(deep);
+}
+
+/*紧凑文档：解析、和cjson树互相转换的结果都和cjson_Parse一样，多深的文档都可以*/
+static void test_doc(void) {
+  cjson_Context ctx;
+  cjson_Doc *doc, *from;
+  cjson *root, *back;
+  text json = {0};
+  char *deep;
+  int i;
+  cjson_InitContext(&ctx, 0);
+  for (i = 0; i < 200; ++i) {
+    json.len = 0;
+    random_value(&json, 5);
+    root = cjson_Parse(json.buf);
+    doc = cjson_DocParse(json.buf);
+    CHECK(doc != 0);
+    back = cjson_DocToTree(doc, cjson_DocRoot(doc));
+    CHECK(same_tree(root, back));
+    cjson_Delete(back);
+    from = cjson_DocFromTree(root);
+    back = cjson_DocToTree(from, cjson_DocRoot(from));
+    CHECK(same_tree(root, back));
+    CHECK(cjson_DocMemorySize(from) > 0);
+    cjson_Delete(back);
+    cjson_DocDelete(from);
+    cjson_DocDelete(doc);
+    cjson_Delete(root);
+    /*惰性解析的树不用先取值*/
+    ctx.options = cjson_Option_Lazy;
+    root = cjson_ParseWithContext(&ctx, json.buf, 0, 1);
+    from = cjson_DocFromTree(root);
+    back = cjson_DocToTree(from, cjson_DocRoot(from));
+    ctx.options = 0;
+    cjson_Delete(root);
+    root = cjson_Parse(json.buf);
+    CHECK(same_tree(root, back));
+    cjson_Delete(back);
+    cjson_DocDelete(from);
+    cjson_Delete(root);
+  }
+  free(json.buf);
+
+  deep = deep_arrays(2000000, 1);
+  doc = cjson_DocParse(deep);
+  CHECK(doc != 0);
+  root = cjson_DocToTree(doc, cjson_DocRoot(doc));
+  CHECK(root != 0);
+  from = cjson_DocFromTree(root);
+  CHECK(from && cjson_DocMemorySize(from) == cjson_DocMemorySize(doc));
+  CHECK(cjson_GetArraySize(root) == 1 && cjson_DocSize(doc, cjson_DocRoot(doc)) == 1);
+  cjson_DocDelete(from);
+  cjson_DocDelete(doc);
+  cjson_Delete(root);
+  CHECK(!cjson_DocParseWithLengthContext(&ctx, deep, 4000000, 0, 1));
+  CHECK(ctx.error == cjson_Error_Depth && ctx.error_ptr == deep + CJSON_NESTING_LIMIT);
+  ctx.max_depth = 0;/*少一层开头，多出一个]*/
+  CHECK(!cjson_DocParseWithLengthContext(&ctx, deep + 1, 3999999, 0, 1));
+  CHECK(ctx.error == cjson_Error_Syntax && ctx.error_ptr == deep + 3999999);
+  free(deep);
+}
+
+/*对惰性值的引用：先在被引用的节点上转换，引用和它看到同一个值，删除时不泄漏*/
+static void test_lazy_reference(void) {
+  const char *json = "{\"s\":\"hello\",\"e\":\"a\\nb\",\"n\":12.5,\"arr\":[\"x\"]}";
+  cjson_Context ctx, arena_ctx;
+  cjson *root, *refs, *s;
+  char *out;
+  cjson_InitContext(&ctx, 0);
+  ctx.options = cjson_Option_Lazy;
+  root = cjson_ParseWithContext(&ctx, json, 0, 1);
+  CHECK(root && (cjson_GetObjectItem(root, "s")->type & cjson_IsLazy));
+  refs = cjson_CreateArray();
+  cjson_AddItemReferenceToArray(refs, cjson_GetObjectItem(root, "s"));
+  cjson_AddItemReferenceToArray(refs, cjson_GetObjectItem(root, "e"));
+  cjson_AddItemReferenceToArray(refs, cjson_GetObjectItem(root, "n"));
+  cjson_AddItemReferenceToObject(refs, "arr", cjson_GetObjectItem(root, "arr"));
+  CHECK(cjson_GetArraySize(refs) == 4);
+  CHECK(!(cjson_GetObjectItem(root, "s")->type & cjson_IsLazy));
+  CHECK(!(cjson_GetArrayItem(refs, 0)->type & cjson_IsLazy));
+  CHECK(!strcmp(cjson_GetStringValue(cjson_GetArrayItem(refs, 0)), "hello"));
+  CHECK(cjson_GetStringValue(cjson_GetArrayItem(refs, 0)) == cjson_GetStringValue(cjson_GetObjectItem(root, "s")));
+  CHECK(!strcmp(cjson_GetStringValue(cjson_GetArrayItem(refs, 1)), "a\nb"));
+  CHECK(cjson_GetNumberValue(cjson_GetArrayItem(refs, 2)) == 12.5);
+  CHECK(!strcmp(cjson_GetStringValue(cjson_GetArrayItem(refs, 3)->child), "x"));
+  out = cjson_PrintUnformatted(refs);
+  CHECK(out && !strcmp(out, "[\"hello\",\"a\\nb\",12.5,[\"x\"]]"));
+  free(out);
+  cjson_Delete(refs);
+  cjson_DeleteWithContext(&ctx, root);
+
+  /*给惰性的数字设新值，取值、输出和复制都用新值*/
+  root = cjson_ParseWithContext(&ctx, "{\"a\":1.5,\"b\":[7]}", 0, 1);
+  s = cjson_GetObjectItem(root, "a");
+  CHECK(s && (s->type & cjson_IsLazy));
+  cjson_SetNumberValue(s, 42);
+  cjson_SetIntValue(cjson_GetObjectItem(root, "b")->child, -3);
+  CHECK(!(s->type & cjson_IsLazy) && s->valuestring == 0);
+  CHECK(cjson_GetNumberValue(s) == 42 && cjson_GetInt64Value(s) == 42 && s->valueint == 42);
+  out = cjson_PrintUnformatted(root);
+  CHECK(out && !strcmp(out, "{\"a\":42,\"b\":[-3]}"));
+  free(out);
+  refs = cjson_Duplicate(root, 1);
+  out = cjson_PrintUnformatted(refs);
+  CHECK(out && !strcmp(out, "{\"a\":42,\"b\":[-3]}"));
+  free(out);
+  cjson_Delete(refs);
+  cjson_DeleteWithContext(&ctx, root);
+
+  /*arena中的惰性字符串要先用带arena的上下文取值*/
+  arena_ctx = ctx;
+  arena_ctx.arena = cjson_ArenaCreate(0);
+  root = cjson_ParseWithContext(&arena_ctx, json, 0, 1);
+  s = cjson_GetObjectItem(root, "s");
+  refs = cjson_CreateArray();
+  cjson_AddItemReferenceToArray(refs, s);
+  CHECK(cjson_GetArraySize(refs) == 0);
+  CHECK(!strcmp(cjson_GetStringValueWithContext(&arena_ctx, s), "hello"));
+  cjson_AddItemReferenceToArray(refs, s);
+  CHECK(cjson_GetArraySize(refs) == 1 && cjson_GetStringValue(refs->child) == s->valuestring);
+  cjson_Delete(refs);
+  cjson_ArenaDestroy(arena_ctx.arena);
+}
+
+/*逐篇取出批量解析的结果，记下每篇的开头偏移、错误码和出错的偏移*/
+static int batch_collect(cjson_Batch *b, size_t *offsets, int *errors, size_t *error_offsets) {
+  cjson *doc;
+  int n = 0;
+  while (cjson_BatchNext(b, &doc)) {
+    offsets[n] = cjson_BatchOffset(b);
+    errors[n] = doc ? cjson_Error_None : cjson_BatchError(b);
+    error_offsets[n] = doc ? 0 : cjson_BatchErrorOffset(b);
+    ++n;
+  }
+  return n;
+}
+
+typedef struct
+{
+  const char *data;
+  size_t pos, len;
+} reader;
+/*每次只给3个字节，让行跨过多次读取*/
+static size_t small_read(void *user, char *data, size_t len) {
+  reader *r = (reader *)user;
+  size_t n = r->len - r->pos < 3 ? r->len - r->pos : 3;
+  if (n > len) n = len;
+  memcpy(data, r->data + r->pos, n);
+  r->pos += n;
+  return n;
+}
+
+static void test_batch(void) {
+  /*三篇文档从0、8、15开始，第二篇在12的}出错*/
+  const char *data = "{\"a\":1}\n[1,2}\n\n{\"b\":2}\n";
+  size_t offsets[8], error_offsets[8];
+  int errors[8], n;
+  cjson_Context ctx;
+  cjson_Batch *b;
+  reader r;
+  cjson_InitContext(&ctx, 0);
+
+  b = cjson_BatchCreateWithContext(&ctx, data, strlen(data));
+  n = batch_collect(b, offsets, errors, error_offsets);
+  cjson_BatchDestroy(b);
+  CHECK(n == 3);
+  CHECK(offsets[0] == 0 && errors[0] == cjson_Error_None);
+  CHECK(offsets[1] == 8 && errors[1] == cjson_Error_Syntax && error_offsets[1] == 12);
+  CHECK(offsets[2] == 15 && errors[2] == cjson_Error_None);
+  CHECK(ctx.error == cjson_Error_None);
+
+  r.data = data;
+  r.pos = 0;
+  r.len = strlen(data);
+  b = cjson_BatchCreateWithReader(&ctx, small_read, &r);
+  n = batch_collect(b, offsets, errors, error_offsets);
+  cjson_BatchDestroy(b);
+  CHECK(n == 3);
+  CHECK(offsets[1] == 8 && errors[1] == cjson_Error_Syntax && error_offsets[1] == 12);
+  CHECK(offsets[2] == 15 && errors[2] == cjson_Error_None);
+
+  /*流模式一行只能有一篇，行尾不完整的文档在换行处出错*/
+  data = "[1,\n{}{}\n7";
+  r.data = data;
+  r.pos = 0;
+  r.len = strlen(data);
+  b = cjson_BatchCreateWithReader(&ctx, small_read, &r);
+  n = batch_collect(b, offsets, errors, error_offsets);
+  cjson_BatchDestroy(b);
+  CHECK(n == 3);
+  CHECK(errors[0] == cjson_Error_Syntax && error_offsets[0] == 3);
+  CHECK(offsets[1] == 4 && errors[1] == cjson_Error_Syntax && error_offsets[1] == 6);
+  CHECK(offsets[2] == 9 && errors[2] == cjson_Error_None);
+
+  /*缓冲模式首尾相接的文档不需要换行*/
+  data = "1 [2]{\"c\":3}\"s\"";
+  b = cjson_BatchCreateWithContext(&ctx, data, strlen(data));
+  n = batch_collect(b, offsets, errors, error_offsets);
+  cjson_BatchDestroy(b);
+  CHECK(n == 4);
+  CHECK(offsets[0] == 0 && offsets[1] == 2 && offsets[2] == 5 && offsets[3] == 12);
+  CHECK(!errors[0] && !errors[1] && !errors[2] && !errors[3]);
+}
+
+/*推式解析：把data在cuts处切开依次喂进去，返回Finish的结果*/
+static cjson *push_parse(const char *data, size_t len, const size_t *cuts, int ncuts) {
+  cjson_PushParser *pp = cjson_PushParserCreate();
+  cjson *root;
+  size_t at = 0;
+  int i;
+  for (i = 0; i <= ncuts; ++i) {
+    size_t next = i < ncuts ? cuts[i] : len;
+    cjson_PushParserFeed(pp, data + at, next - at);
+    at = next;
+  }
+  root = cjson_PushParserFinish(pp);
+  cjson_PushParserDestroy(pp);
+  return root;
+}
+
+/*在每个字节处切成两块、每两个字节处切成三块、逐字节喂，结果都要和一次解析一样*/
+static void check_push(const char *data, int line) {
+  size_t len = strlen(data), cuts[2], i, j;
+  cjson *whole = cjson_ParseWithOpts(data, 0, 1), *root;
+  int ok = 1;
+  for (i = 0; i <= len && ok; ++i) {
+    cuts[0] = i;
+    root = push_parse(data, len, cuts, 1);
+    ok = same_tree(whole, root);
+    cjson_Delete(root);
+    for (j = i; j <= len && ok && len <= 64; ++j) {
+      cuts[1] = j;
+      root = push_parse(data, len, cuts, 2);
+      ok = same_tree(whole, root);
+      cjson_Delete(root);
+    }
+  }
+  if (ok) {
+    cjson_PushParser *pp = cjson_PushParserCreate();
+    for (i = 0; i < len; ++i) cjson_PushParserFeed(pp, data + i, 1);
+    root = cjson_PushParserFinish(pp);
+    ok = same_tree(whole, root);
+    cjson_Delete(root);
+    cjson_PushParserDestroy(pp);
+  }
+  check(ok, data, line);
+  cjson_Delete(whole);
+}
+
+static void test_push(void) {
+  static const char *cases[] = {
+    "{\"a\":[1,2.5,-3e10,true,false,null],\"b\":{\"c\":\"d\"}}",
+    "  [ \"\\u00e9\\ud83d\\ude00\\n\\\"\\\\\" , 12345678901234567890 , -0.000001e-5 ]  ",
+    "\"long string with an escape \\t in the middle and some more text\"",
+    "-9223372036854775808", "1.7976931348623157e308", "true", "null", "0",
+    "[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]",
+    "{\"\\u0041\\u0042\":{\"\":[{},[],\"\"]}}",
+    /*出错的文档两种方式都返回0*/
+    "[1,2", "{\"a\" 1}", "[1,]", "\"\\ud83d\"x", "tru", "[1] 2", "01", "-", "\"abc",
+  };
+  text doc = {0};
+  int i;
+  for (i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); ++i) check_push(cases[i], __LINE__);
+  for (i = 0; i < 30; ++i) {
+    doc.len = 0;
+    random_value(&doc, 4);
+    check_push(doc.buf, __LINE__);
+  }
+  free(doc.buf);
+}
+
+static void test_parallel(void) {
+  text doc = {0}, lines = {0};
+  cjson *serial, *parallel, *it;
+  char *bad;
+  int i;
+  /*一个三百多KB的顶层数组，够分给4个线程*/
+  text_add(&doc, "[");
+  for (i = 0; i < 12000; ++i) {
+    if (i) text_add(&doc, i % 7 ? "," : ",\n");
+    random_value(&doc, 4);
+  }
+  text_add(&doc, "]");
+  serial = cjson_ParseWithLengthOpts(doc.buf, doc.len, 0, 1);
+  CHECK(serial != 0);
+  parallel = cjson_ParseParallel(doc.buf, doc.len, 4);
+  CHECK(same_tree(serial, parallel));
+  CHECK(cjson_GetArraySize(parallel) == 12000 && doc.len > 4 * 64 * 1024);
+  cjson_Delete(parallel);
+
+  /*同样的元素每行一篇*/
+  for (it = serial->child; it; it = it->next) {
+    char *out = cjson_PrintUnformatted(it);
+    text_add(&lines, out);
+    text_add(&lines, "\n");
+    free(out);
+  }
+  parallel = cjson_ParseLinesParallel(lines.buf, lines.len, 4);
+  CHECK(same_tree(serial, parallel));
+  cjson_Delete(parallel);
+  cjson_Delete(serial);
+
+  /*出错时和串行解析报告同一个位置*/
+  bad = strchr(doc.buf + doc.len / 2, ',');/*逗号不会在字符串里*/
+  *bad = '}';
+  serial = cjson_ParseWithLengthOpts(doc.buf, doc.len, 0, 1);
+  CHECK(serial == 0);
+  {
+    const char *serial_error = cjson_GetErrorPtr();
+    CHECK(cjson_ParseParallel(doc.buf, doc.len, 4) == 0);
+    CHECK(cjson_GetErrorPtr() == serial_error);
+  }
+  /*出错后串行重新解析，统计和只串行解析一次一样，各线程的不算进去。冒号在分段时发现不了，要各线程解析时才出错*/
+  *bad = ':';
+  {
+    cjson_Stats serial_stats, parallel_stats;
+    cjson_Context ctx;
+    cjson_InitContext(&ctx, 0);
+    memset(&serial_stats, 0, sizeof(serial_stats));
+    memset(&parallel_stats, 0, sizeof(parallel_stats));
+    ctx.stats = &serial_stats;
+    CHECK(cjson_ParseWithLengthContext(&ctx, doc.buf, doc.len, 0, 1) == 0);
+    ctx.stats = &parallel_stats;
+    CHECK(cjson_ParseParallelWithContext(&ctx, doc.buf, doc.len, 4) == 0);
+    CHECK(parallel_stats.nodes == serial_stats.nodes && parallel_stats.allocs == serial_stats.allocs);
+    CHECK(parallel_stats.bytes == serial_stats.bytes && parallel_stats.strings == serial_stats.strings);
+    CHECK(parallel_stats.strings_escaped == serial_stats.strings_escaped);
+    CHECK(parallel_stats.max_depth == serial_stats.max_depth);
+    CHECK(parallel_stats.parses == serial_stats.parses && parallel_stats.deletes == serial_stats.deletes);
+    CHECK(!cjson_StatsEnabled() || serial_stats.nodes > 1000);
+  }
+  free(doc.buf);
+  free(lines.buf);
+}
+
+/*节点池的块用单独计数的钩子申请，看反复解析和删除时块有没有增加*/
+static int pool_allocs;
+static void *pool_malloc(size_t sz) {
+  ++pool_allocs;
+  return malloc(sz);
+}
+
+#ifndef CJSON_NO_THREADS
+/*在另一个线程里从池中取放节点，让它的缓存里留着节点，等池销毁后再退出*/
+typedef struct
+{
+  cjson_Context *ctx;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  int stage;
+} pool_user;
+static void *pool_user_thread(void *arg) {
+  pool_user *u = (pool_user *)arg;
+  cjson_DeleteWithContext(u->ctx, cjson_ParseWithContext(u->ctx, "[1,2,3]", 0, 1));
+  pthread_mutex_lock(&u->lock);
+  u->stage = 1;
+  pthread_cond_signal(&u->cond);
+  while (u->stage != 2) pthread_cond_wait(&u->cond, &u->lock);
+  pthread_mutex_unlock(&u->lock);
+  return 0;
+}
+#endif
+
+static void test_pool(void) {
+  cjson_Hooks hooks = {pool_malloc, free};
+  cjson_Context pool_ctx, ctx;
+  cjson_Pool *pool;
+  text doc = {0};
+  cjson *root, *serial;
+  int i, slabs = 0;
+  cjson_InitContext(&pool_ctx, &hooks);
+  cjson_InitContext(&ctx, 0);
+  /*三百多KB，并行解析能分给4个线程*/
+  text_add(&doc, "[");
+  for (i = 0; i < 12000; ++i) {
+    if (i) text_add(&doc, ",");
+    random_value(&doc, 4);
+  }
+  text_add(&doc, "]");
+  serial = cjson_ParseWithLengthOpts(doc.buf, doc.len, 0, 1);
+  CHECK(serial != 0 && doc.len > 4 * 64 * 1024);
+
+  /*只给一个线程用的池：删掉的节点给下一次解析用*/
+  pool = cjson_PoolCreateWithContext(&pool_ctx, 256, 0);
+  ctx.pool = pool;
+  for (i = 0; i < 10; ++i) {
+    root = cjson_ParseWithLengthContext(&ctx, doc.buf, doc.len, 0, 1);
+    CHECK(root && (root->type & cjson_IsPooled) && same_tree(root, serial));
+    cjson_DeleteWithContext(&ctx, root);
+    if (!i) slabs = pool_allocs;
+  }
+  CHECK(pool_allocs == slabs);
+  cjson_PoolDestroy(pool);
+
+#ifndef CJSON_NO_THREADS
+  /*
+    共用的池：并行解析和后台删除的线程退出时把缓存的节点还回来，跑过几轮以后块数不再增加。
+    线程的先后会让各个缓存里留下的节点数不一样，允许多一块；线程带走缓存时每几轮就要多一块
+  */
+  pool = cjson_PoolCreateWithContext(&pool_ctx, 256, cjson_Pool_Shared);
+  ctx.pool = pool;
+  for (i = 0; i < 40; ++i) {
+    root = cjson_ParseParallelWithContext(&ctx, doc.buf, doc.len, 4);
+    CHECK(root && (root->type & cjson_IsPooled) && same_tree(root, serial));
+    cjson_DeleteWithContext(&ctx, root);
+    if (i == 9) slabs = pool_allocs;
+  }
+  CHECK(pool_allocs <= slabs + 1);
+  cjson_PoolDestroy(pool);
+  pool = cjson_PoolCreateWithContext(&pool_ctx, 256, cjson_Pool_Shared);
+  ctx.pool = pool;
+  for (i = 0; i < 40; ++i) {
+    cjson_Reclaimer *r = cjson_ReclaimerCreateWithContext(&ctx);
+    cjson_DeleteLater(r, cjson_ParseWithLengthContext(&ctx, doc.buf, doc.len, 0, 1));
+    cjson_ReclaimerDestroy(r);
+    if (i == 9) slabs = pool_allocs;
+  }
+  CHECK(pool_allocs <= slabs + 1);
+
+  /*池销毁时另一个线程的缓存里还有它的节点：那个线程退出时丢掉缓存，不碰已经释放的块*/
+  {
+    pool_user u;
+    pthread_t tid;
+    u.ctx = &ctx;
+    u.stage = 0;
+    pthread_mutex_init(&u.lock, 0);
+    pthread_cond_init(&u.cond, 0);
+    CHECK(!pthread_create(&tid, 0, pool_user_thread, &u));
+    pthread_mutex_lock(&u.lock);
+    while (u.stage != 1) pthread_cond_wait(&u.cond, &u.lock);
+    cjson_PoolDestroy(pool);
+    u.stage = 2;
+    pthread_cond_signal(&u.cond);
+    pthread_mutex_unlock(&u.lock);
+    pthread_join(tid, 0);
+    pthread_cond_destroy(&u.cond);
+    pthread_mutex_destroy(&u.lock);
+  }
+  /*新池可能用同一个地址，不能收到旧池的节点*/
+  pool = cjson_PoolCreateWithContext(&pool_ctx, 256, cjson_Pool_Shared);
+  ctx.pool = pool;
+  root = cjson_ParseParallelWithContext(&ctx, doc.buf, doc.len, 4);
+  CHECK(root && same_tree(root, serial));
+  cjson_DeleteWithContext(&ctx, root);
+  cjson_PoolDestroy(pool);
+#endif
+  cjson_Delete(serial);
+  free(doc.buf);
+}
+
+/*
+  默认上下文不限制嵌套深度，所以所有接口都不能递归：
+  200万层的文档走一遍解析、输出、复制、删除、推式解析、惰性解析、批量和并行解析
+*/
+static void test_deep(void) {
+  size_t n = 2000000, len = 2 * n;
+  char *deep = deep_arrays(n, 1), *out;
+  cjson_Context ctx;
+  cjson_PushParser *pp;
+  cjson_Batch *b;
+  cjson *root, *copy, *it;
+  size_t levels = 0;
+  root = cjson_ParseWithLength(deep, len);
+  CHECK(root != 0);
+  for (it = root; it; it = it->child) ++levels;
+  CHECK(levels == n);
+  out = cjson_PrintUnformatted(root);
+  CHECK(out && !strcmp(out, deep));
+  free(out);
+  copy = cjson_Duplicate(root, 1);
+  CHECK(same_tree(root, copy));
+  cjson_Delete(copy);
+  cjson_Delete(root);
+
+  pp = cjson_PushParserCreate();
+  CHECK(cjson_PushParserFeed(pp, deep, n) == cjson_Error_None);
+  CHECK(cjson_PushParserFeed(pp, deep + n, n) == cjson_Error_None);
+  root = cjson_PushParserFinish(pp);
+  CHECK(root != 0);
+  cjson_Delete(root);
+  cjson_PushParserDestroy(pp);
+
+  cjson_InitContext(&ctx, 0);
+  ctx.max_depth = 0;
+  ctx.options = cjson_Option_Lazy;
+  root = cjson_ParseWithLengthContext(&ctx, deep, len, 0, 1);
+  CHECK(root != 0);
+  cjson_DeleteWithContext(&ctx, root);
+
+  ctx.options = 0;
+  b = cjson_BatchCreateWithContext(&ctx, deep, len);
+  CHECK(cjson_BatchNext(b, &root) && root != 0);
+  cjson_BatchDestroy(b);
+  root = cjson_ParseParallel(deep, len, 2);
+  CHECK(root != 0);
+  cjson_Delete(root);
+  free(deep);
+}
+
+int main(void) {
+  test_numbers();
+  test_long_mantissa();
+  test_print_numbers();
+  test_index();
+  test_stream_print();
+  test_stream_print_context();
+  test_push();
+  test_sax();
+  test_doc();
+  test_lazy_reference();
+  test_batch();
+  test_parallel();
+  test_pool();
+  test_deep();
+  printf("%d checks, %d failed\n", checks, failures);
+  return failures != 0;
+}